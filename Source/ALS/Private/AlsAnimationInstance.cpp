@@ -2,7 +2,10 @@
 
 #include "AlsAnimationInstanceProxy.h"
 #include "AlsCharacter.h"
+#include "AlsOverlayStreamingSubsystem.h"
 #include "DrawDebugHelpers.h"
+#include "Animation/AnimClassInterface.h"
+#include "Animation/AnimNode_LinkedAnimLayer.h"
 #include "Components/CapsuleComponent.h"
 #include "Curves/CurveFloat.h"
 #include "Engine/SkeletalMesh.h"
@@ -19,6 +22,9 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AlsAnimationInstance)
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Overlay Layer Relinks"), STAT_AlsOverlayLayerRelinks, STATGROUP_Als)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Overlay Layer Instances Created"), STAT_AlsOverlayLayerInstancesCreated, STATGROUP_Als)
+
 ALS_DEFINE_PRIVATE_MEMBER_ACCESSOR(AlsGetAnimationCurvesAccessor, &FAnimInstanceProxy::GetAnimationCurves,
                                    const TMap<FName, float>& (FAnimInstanceProxy::*)(EAnimCurveType) const)
 
@@ -132,6 +138,8 @@ void UAlsAnimationInstance::NativeUpdateAnimation(const float DeltaTime)
 	Gait = Character->GetGait();
 	OverlayMode = Character->GetOverlayMode();
 
+	RefreshOverlayLayersOnGameThread();
+
 	if (LocomotionAction != Character->GetLocomotionAction())
 	{
 		LocomotionAction = Character->GetLocomotionAction();
@@ -212,6 +220,14 @@ void UAlsAnimationInstance::NativePostUpdateAnimation()
 	bPendingUpdate = false;
 }
 
+void UAlsAnimationInstance::NativeUninitializeAnimation()
+{
+	ReleaseOverlayLayerInstances();
+	ReleaseOverlayLayerClasses();
+
+	Super::NativeUninitializeAnimation();
+}
+
 FAnimInstanceProxy* UAlsAnimationInstance::CreateAnimInstanceProxy()
 {
 	return new FAlsAnimationInstanceProxy{this};
@@ -1375,6 +1391,20 @@ void UAlsAnimationInstance::RefreshFootLock(const float IkAmount, FAlsFootState&
 	FootState.FinalRotation = FQuat4f{ComponentTransformInverse.TransformRotation(FinalRotation)};
 }
 
+void UAlsAnimationInstance::SetFootGroundHit(const EAlsFootBone FootBone, const FHitResult& Hit)
+{
+	auto& FootGroundHit{FootBone == EAlsFootBone::Left ? FootGroundCache.Left : FootGroundCache.Right};
+
+	FootGroundHit.bValid = Hit.bBlockingHit;
+	FootGroundHit.TraceStart = Hit.TraceStart;
+	FootGroundHit.TraceEnd = Hit.TraceEnd;
+	FootGroundHit.ImpactPoint = Hit.ImpactPoint;
+	FootGroundHit.ImpactNormal = Hit.ImpactNormal;
+	FootGroundHit.Component = Hit.Component;
+	FootGroundHit.PhysicalMaterial = Hit.PhysMaterial;
+	FootGroundHit.Time = GetWorld()->GetTimeSeconds();
+}
+
 void UAlsAnimationInstance::PlayQuickStopAnimation()
 {
 	if (!IsValid(Settings))
@@ -1834,6 +1864,354 @@ void UAlsAnimationInstance::PlayQueuedTurnInPlaceAnimation()
 	TurnInPlaceState.QueuedTurnYawAngle = 0.0f;
 }
 
+void UAlsAnimationInstance::PrefetchOverlayLayers(const FGameplayTagContainer& OverlayModes)
+{
+	auto* StreamingSubsystem{GetWorld()->GetSubsystem<UAlsOverlayStreamingSubsystem>()};
+	if (!IsValid(Settings) || !IsValid(StreamingSubsystem))
+	{
+		return;
+	}
+
+	// Add the new references before removing the old ones, so that layer classes
+	// that are prefetched again are not released and streamed once more.
+
+	TArray<TSoftClassPtr<UAnimInstance>> NewPrefetchedLayerClasses;
+	NewPrefetchedLayerClasses.Reserve(OverlayModes.Num());
+
+	for (const auto& PrefetchedOverlayMode : OverlayModes)
+	{
+		const auto* LayerClass{Settings->OverlayLayers.LayerClasses.Find(PrefetchedOverlayMode)};
+
+		if (LayerClass != nullptr && !LayerClass->IsNull() && !NewPrefetchedLayerClasses.Contains(*LayerClass))
+		{
+			StreamingSubsystem->AddLayerClassReference(*LayerClass);
+			NewPrefetchedLayerClasses.Add(*LayerClass);
+		}
+	}
+
+	for (const auto& LayerClass : PrefetchedOverlayLayerClasses)
+	{
+		StreamingSubsystem->RemoveLayerClassReference(LayerClass);
+	}
+
+	PrefetchedOverlayLayerClasses = MoveTemp(NewPrefetchedLayerClasses);
+
+	bOverlayLayerInstancesRefreshPending = true;
+}
+
+int64 UAlsAnimationInstance::GetResidentOverlayLayersMemory() const
+{
+	const auto* StreamingSubsystem{GetWorld()->GetSubsystem<UAlsOverlayStreamingSubsystem>()};
+	if (!IsValid(StreamingSubsystem))
+	{
+		return 0;
+	}
+
+	int64 Memory{0};
+
+	for (const auto& LayerClass : RecentOverlayLayerClasses)
+	{
+		Memory += StreamingSubsystem->GetLayerClassAnimationsMemory(LayerClass);
+	}
+
+	for (const auto& LayerClass : PrefetchedOverlayLayerClasses)
+	{
+		if (!RecentOverlayLayerClasses.Contains(LayerClass))
+		{
+			Memory += StreamingSubsystem->GetLayerClassAnimationsMemory(LayerClass);
+		}
+	}
+
+	return Memory;
+}
+
+void UAlsAnimationInstance::RefreshOverlayLayersOnGameThread()
+{
+	const auto& LayersSettings{Settings->OverlayLayers};
+
+	if (LayersSettings.LayerClasses.IsEmpty() && !IsValid(LayersSettings.DefaultLayerClass) &&
+	    !IsValid(LinkedOverlayLayerClass) && OverlayLayerInstances.IsEmpty())
+	{
+		return;
+	}
+
+	TSubclassOf<UAnimInstance> NewLayerClass{LayersSettings.DefaultLayerClass};
+
+	const auto* LayerClass{LayersSettings.LayerClasses.Find(OverlayMode)};
+	if (LayerClass != nullptr && !LayerClass->IsNull())
+	{
+		AddRecentOverlayLayerClass(*LayerClass);
+
+		// Until the layer class is streamed, the default layer class is used instead of blocking
+		// on a synchronous load. This is checked on every update, so the layer class will be
+		// linked as soon as it's streamed. Outside of game worlds, such as in the editor
+		// preview, there is no streaming subsystem, so the layer class is loaded synchronously.
+
+		auto* LoadedLayerClass{
+			IsValid(GetWorld()->GetSubsystem<UAlsOverlayStreamingSubsystem>()) ? LayerClass->Get() : LayerClass->LoadSynchronous()
+		};
+
+		if (IsValid(LoadedLayerClass))
+		{
+			NewLayerClass = LoadedLayerClass;
+		}
+	}
+
+	// Relink only if the layer class actually changes. Since this happens once per
+	// update, overlay mode changes within a single frame are coalesced.
+
+	if (NewLayerClass != LinkedOverlayLayerClass)
+	{
+		RelinkOverlayLayers(NewLayerClass);
+
+		// The pool is refreshed starting from the next update, so that it doesn't add to the cost of the switch itself.
+
+		bOverlayLayerInstancesRefreshPending = true;
+		return;
+	}
+
+	if (bOverlayLayerInstancesRefreshPending)
+	{
+		RefreshOverlayLayerInstances();
+	}
+}
+
+void UAlsAnimationInstance::AddRecentOverlayLayerClass(const TSoftClassPtr<UAnimInstance>& LayerClass)
+{
+	if (!RecentOverlayLayerClasses.IsEmpty() && RecentOverlayLayerClasses[0] == LayerClass)
+	{
+		return;
+	}
+
+	auto* StreamingSubsystem{GetWorld()->GetSubsystem<UAlsOverlayStreamingSubsystem>()};
+	if (!IsValid(StreamingSubsystem))
+	{
+		return;
+	}
+
+	const auto LayerClassIndex{RecentOverlayLayerClasses.Find(LayerClass)};
+	if (LayerClassIndex != INDEX_NONE)
+	{
+		RecentOverlayLayerClasses.RemoveAt(LayerClassIndex, EAllowShrinking::No);
+	}
+	else
+	{
+		StreamingSubsystem->AddLayerClassReference(LayerClass);
+	}
+
+	RecentOverlayLayerClasses.Insert(LayerClass, 0);
+
+	while (RecentOverlayLayerClasses.Num() > FMath::Max(1, Settings->OverlayLayers.RecentLayerClassesCount))
+	{
+		StreamingSubsystem->RemoveLayerClassReference(RecentOverlayLayerClasses.Pop(EAllowShrinking::No));
+	}
+}
+
+void UAlsAnimationInstance::ReleaseOverlayLayerClasses()
+{
+	auto* StreamingSubsystem{IsValid(GetWorld()) ? GetWorld()->GetSubsystem<UAlsOverlayStreamingSubsystem>() : nullptr};
+	if (IsValid(StreamingSubsystem))
+	{
+		for (const auto& LayerClass : RecentOverlayLayerClasses)
+		{
+			StreamingSubsystem->RemoveLayerClassReference(LayerClass);
+		}
+
+		for (const auto& LayerClass : PrefetchedOverlayLayerClasses)
+		{
+			StreamingSubsystem->RemoveLayerClassReference(LayerClass);
+		}
+	}
+
+	RecentOverlayLayerClasses.Reset();
+	PrefetchedOverlayLayerClasses.Reset();
+}
+
+void UAlsAnimationInstance::RelinkOverlayLayers(UClass* NewLayerClass)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("UAlsAnimationInstance::RelinkOverlayLayers"),
+	                            STAT_UAlsAnimationInstance_RelinkOverlayLayers, STATGROUP_Als)
+
+	auto* NewInstance{FindOverlayLayerInstance(NewLayerClass)};
+
+	// The instance of the new layer class is created immediately if it is not pooled yet, because it's needed right now.
+
+	if (IsValid(NewLayerClass) && !IsValid(NewInstance))
+	{
+		NewInstance = CreateOverlayLayerInstance(NewLayerClass);
+	}
+
+	LinkOverlayLayerInstance(NewInstance);
+
+	LinkedOverlayLayerClass = NewLayerClass;
+
+	INC_DWORD_STAT(STAT_AlsOverlayLayerRelinks)
+}
+
+void UAlsAnimationInstance::RefreshOverlayLayerInstances()
+{
+	const auto& LayersSettings{Settings->OverlayLayers};
+
+	// Layer classes that should have pooled instances, in order of priority. Layer classes that are still
+	// streaming are skipped, their instances will be created on the next refresh after they are streamed.
+
+	TArray<UClass*, TInlineAllocator<8>> LayerClasses;
+
+	if (IsValid(LinkedOverlayLayerClass))
+	{
+		LayerClasses.Add(LinkedOverlayLayerClass);
+	}
+
+	for (const auto& LayerClass : RecentOverlayLayerClasses)
+	{
+		if (IsValid(LayerClass.Get()))
+		{
+			LayerClasses.AddUnique(LayerClass.Get());
+		}
+	}
+
+	for (const auto& LayerClass : PrefetchedOverlayLayerClasses)
+	{
+		if (IsValid(LayerClass.Get()))
+		{
+			LayerClasses.AddUnique(LayerClass.Get());
+		}
+	}
+
+	if (IsValid(LayersSettings.DefaultLayerClass))
+	{
+		LayerClasses.AddUnique(LayersSettings.DefaultLayerClass);
+	}
+
+	if (LayerClasses.Num() > LayersSettings.MaxLayerInstancesCount)
+	{
+		LayerClasses.SetNum(FMath::Max(1, LayersSettings.MaxLayerInstancesCount), EAllowShrinking::No);
+	}
+
+	// The linked instance is always the first in order of priority, so it is never destroyed here.
+
+	OverlayLayerInstances.RemoveAll([this, &LayerClasses](const TObjectPtr<UAnimInstance>& Instance)
+	{
+		if (!IsValid(Instance))
+		{
+			return true;
+		}
+
+		if (Instance == LinkedOverlayLayerInstance || LayerClasses.Contains(Instance->GetClass()))
+		{
+			return false;
+		}
+
+		Instance->UninitializeAnimation();
+		Instance->MarkAsGarbage();
+		return true;
+	});
+
+	// Instances are created at most one per update to spread the cost of initialization.
+	// The refresh stops once all wanted instances that can be created are pooled.
+
+	for (auto* LayerClass : LayerClasses)
+	{
+		if (!IsValid(FindOverlayLayerInstance(LayerClass)))
+		{
+			CreateOverlayLayerInstance(LayerClass);
+			return;
+		}
+	}
+
+	bOverlayLayerInstancesRefreshPending = false;
+}
+
+UAnimInstance* UAlsAnimationInstance::CreateOverlayLayerInstance(UClass* LayerClass)
+{
+	// Unlike the instances created by LinkAnimClassLayers(), these instances are not marked as
+	// created by a linked animation graph, so the layer nodes don't destroy them when rebound.
+
+	auto* Instance{NewObject<UAnimInstance>(GetSkelMeshComponent(), LayerClass)};
+	Instance->InitializeAnimation();
+
+	OverlayLayerInstances.Add(Instance);
+
+	INC_DWORD_STAT(STAT_AlsOverlayLayerInstancesCreated)
+
+	return Instance;
+}
+
+UAnimInstance* UAlsAnimationInstance::FindOverlayLayerInstance(const UClass* LayerClass) const
+{
+	if (!IsValid(LayerClass))
+	{
+		return nullptr;
+	}
+
+	const auto* Instance{
+		OverlayLayerInstances.FindByPredicate([LayerClass](const TObjectPtr<UAnimInstance>& PooledInstance)
+		{
+			return IsValid(PooledInstance) && PooledInstance->GetClass() == LayerClass;
+		})
+	};
+
+	return Instance != nullptr ? Instance->Get() : nullptr;
+}
+
+void UAlsAnimationInstance::LinkOverlayLayerInstance(UAnimInstance* NewInstance)
+{
+	const auto* AnimationClassInterface{IAnimClassInterface::GetFromClass(GetClass())};
+	if (AnimationClassInterface == nullptr)
+	{
+		return;
+	}
+
+	// Same as LinkAnimClassLayers(), but binds the layer nodes to the pooled instance instead of creating a new one.
+	// Only the layer nodes whose interfaces are implemented by the layer class are bound to it, and the nodes
+	// that were bound to the previously linked instance fall back to their own layer implementations.
+
+	for (const auto* LayerNodeProperty : AnimationClassInterface->GetLinkedAnimLayerNodeProperties())
+	{
+		auto* LayerNode{LayerNodeProperty->ContainerPtrToValuePtr<FAnimNode_LinkedAnimLayer>(this)};
+
+		if (IsValid(NewInstance) && IsValid(LayerNode->Interface) && NewInstance->GetClass()->ImplementsInterface(LayerNode->Interface))
+		{
+			LayerNode->SetLinkedLayerInstance(this, NewInstance);
+		}
+		else if (IsValid(LinkedOverlayLayerInstance) && LayerNode->GetTargetInstance<UAnimInstance>() == LinkedOverlayLayerInstance)
+		{
+			LayerNode->SetLinkedLayerInstance(this, nullptr);
+		}
+	}
+
+	auto& LinkedInstances{GetSkelMeshComponent()->GetLinkedAnimInstances()};
+
+	if (IsValid(LinkedOverlayLayerInstance))
+	{
+		LinkedInstances.Remove(LinkedOverlayLayerInstance);
+	}
+
+	if (IsValid(NewInstance))
+	{
+		LinkedInstances.AddUnique(NewInstance);
+	}
+
+	LinkedOverlayLayerInstance = NewInstance;
+}
+
+void UAlsAnimationInstance::ReleaseOverlayLayerInstances()
+{
+	// The linked instance is registered with the skeletal mesh, which takes care of it, so only the idle instances are destroyed.
+
+	for (const auto& Instance : OverlayLayerInstances)
+	{
+		if (IsValid(Instance) && Instance != LinkedOverlayLayerInstance)
+		{
+			Instance->UninitializeAnimation();
+			Instance->MarkAsGarbage();
+		}
+	}
+
+	OverlayLayerInstances.Reset();
+	bOverlayLayerInstancesRefreshPending = false;
+}
+
 void UAlsAnimationInstance::RefreshRagdollingOnGameThread()
 {
 	check(IsInGameThread())
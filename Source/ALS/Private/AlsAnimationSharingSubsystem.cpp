@@ -0,0 +1,333 @@
+#include "AlsAnimationSharingSubsystem.h"
+
+#include "AlsAnimationInstance.h"
+#include "AlsCharacter.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Settings/AlsCharacterSettings.h"
+#include "Utility/AlsUtility.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsAnimationSharingSubsystem)
+
+static TAutoConsoleVariable<bool> CVarAnimationSharingEnabled(
+	TEXT("ALS.AnimationSharing.Enabled"),
+	true,
+	TEXT("Allows distant characters with animation sharing enabled in their settings to copy the pose of other characters in the same state."));
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Animation Sharing Leaders"), STAT_AlsAnimationSharingLeaders, STATGROUP_Als)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Animation Sharing Followers"), STAT_AlsAnimationSharingFollowers, STATGROUP_Als)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Animation Sharing Leader Changes"), STAT_AlsAnimationSharingLeaderChanges, STATGROUP_Als)
+
+uint32 GetTypeHash(const FAlsAnimationSharingKey& Key)
+{
+	auto Hash{HashCombineFast(GetTypeHash(Key.SkinnedAsset), GetTypeHash(Key.AnimationInstanceClass))};
+
+	Hash = HashCombineFast(Hash, GetTypeHash(Key.LocomotionMode));
+	Hash = HashCombineFast(Hash, GetTypeHash(Key.RotationMode));
+	Hash = HashCombineFast(Hash, GetTypeHash(Key.Stance));
+	Hash = HashCombineFast(Hash, GetTypeHash(Key.Gait));
+	Hash = HashCombineFast(Hash, GetTypeHash(Key.OverlayMode));
+	Hash = HashCombineFast(Hash, GetTypeHash(Key.SpeedBucket));
+
+	return HashCombineFast(Hash, GetTypeHash(Key.DirectionBucket));
+}
+
+void UAlsAnimationSharingSubsystem::Deinitialize()
+{
+	for (auto& SharingCharacter : Characters)
+	{
+		if (SharingCharacter.Character.IsValid())
+		{
+			SetLeader(SharingCharacter, nullptr);
+		}
+	}
+
+	Characters.Reset();
+	LeaderIndices.Reset();
+
+	Super::Deinitialize();
+}
+
+void UAlsAnimationSharingSubsystem::Tick(const float DeltaTime)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(__FUNCTION__);
+
+	Super::Tick(DeltaTime);
+
+	Characters.RemoveAllSwap([](const FAlsAnimationSharingCharacter& SharingCharacter)
+	{
+		return !SharingCharacter.Character.IsValid();
+	}, EAllowShrinking::No);
+
+	if (Characters.IsEmpty())
+	{
+		return;
+	}
+
+	RefreshViewLocations();
+
+	// Without local player cameras there is no way to tell which characters are far enough, so sharing is not allowed.
+
+	const auto bSharingAllowed{CVarAnimationSharingEnabled.GetValueOnGameThread() && !ViewLocations.IsEmpty()};
+
+	for (auto& SharingCharacter : Characters)
+	{
+		SharingCharacter.bEligible = bSharingAllowed && TryGetSharingKey(SharingCharacter.Character.Get(), SharingCharacter.Key) &&
+		                             IsEligible(SharingCharacter);
+
+		SharingCharacter.bCanLead = SharingCharacter.bEligible && CanLead(SharingCharacter.Character.Get());
+	}
+
+	LeaderIndices.Reset();
+
+	// Current leaders keep leading their groups so that followers are not reassigned without a reason.
+
+	for (auto i{0}; i < Characters.Num(); i++)
+	{
+		const auto& SharingCharacter{Characters[i]};
+
+		if (SharingCharacter.bCanLead && SharingCharacter.bShared && SharingCharacter.Leader.IsExplicitlyNull())
+		{
+			LeaderIndices.FindOrAdd(SharingCharacter.Key, i);
+		}
+	}
+
+	for (auto i{0}; i < Characters.Num(); i++)
+	{
+		const auto& SharingCharacter{Characters[i]};
+
+		if (SharingCharacter.bCanLead)
+		{
+			LeaderIndices.FindOrAdd(SharingCharacter.Key, i);
+		}
+	}
+
+	for (auto i{0}; i < Characters.Num(); i++)
+	{
+		auto& SharingCharacter{Characters[i]};
+
+		// Without a character that can lead the group, there is no pose to copy.
+
+		const auto* LeaderIndexPointer{SharingCharacter.bEligible ? LeaderIndices.Find(SharingCharacter.Key) : nullptr};
+
+		if (LeaderIndexPointer == nullptr)
+		{
+			SetLeader(SharingCharacter, nullptr);
+			SharingCharacter.bShared = false;
+			continue;
+		}
+
+		const auto LeaderIndex{*LeaderIndexPointer};
+
+		if (LeaderIndex == i)
+		{
+			SetLeader(SharingCharacter, nullptr);
+			INC_DWORD_STAT(STAT_AlsAnimationSharingLeaders)
+		}
+		else
+		{
+			SetLeader(SharingCharacter, Characters[LeaderIndex].Character.Get());
+			INC_DWORD_STAT(STAT_AlsAnimationSharingFollowers)
+		}
+
+		SharingCharacter.bShared = true;
+	}
+}
+
+TStatId UAlsAnimationSharingSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAlsAnimationSharingSubsystem, STATGROUP_Als);
+}
+
+bool UAlsAnimationSharingSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UAlsAnimationSharingSubsystem::AddCharacter(AAlsCharacter* Character)
+{
+	if (!IsValid(Character) || Characters.ContainsByPredicate([Character](const FAlsAnimationSharingCharacter& SharingCharacter)
+	{
+		return SharingCharacter.Character == Character;
+	}))
+	{
+		return;
+	}
+
+	Characters.Emplace_GetRef().Character = Character;
+}
+
+void UAlsAnimationSharingSubsystem::RemoveCharacter(AAlsCharacter* Character)
+{
+	const auto Index{
+		Characters.IndexOfByPredicate([Character](const FAlsAnimationSharingCharacter& SharingCharacter)
+		{
+			return SharingCharacter.Character == Character;
+		})
+	};
+
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	// Followers of the removed character go back to evaluating their own animation blueprints until the next tick.
+
+	for (auto& SharingCharacter : Characters)
+	{
+		if (SharingCharacter.Leader == Character)
+		{
+			SetLeader(SharingCharacter, nullptr);
+			SharingCharacter.bShared = false;
+		}
+	}
+
+	SetLeader(Characters[Index], nullptr);
+
+	Characters.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+void UAlsAnimationSharingSubsystem::RefreshViewLocations()
+{
+	ViewLocations.Reset();
+
+	for (auto Iterator{GetWorld()->GetPlayerControllerIterator()}; Iterator; ++Iterator)
+	{
+		const auto* Player{Iterator->Get()};
+
+		if (IsValid(Player) && Player->IsLocalController() && IsValid(Player->PlayerCameraManager))
+		{
+			ViewLocations.Add(Player->PlayerCameraManager->GetCameraLocation());
+		}
+	}
+}
+
+bool UAlsAnimationSharingSubsystem::IsEligible(const FAlsAnimationSharingCharacter& SharingCharacter) const
+{
+	const auto* Character{SharingCharacter.Character.Get()};
+
+	if (Character->IsLocallyControlled() && Character->IsPlayerControlled())
+	{
+		return false;
+	}
+
+	const auto& SharingSettings{Character->GetSettings()->AnimationSharing};
+
+	auto MinViewDistance{SharingSettings.MinViewDistance};
+	if (SharingCharacter.bShared)
+	{
+		MinViewDistance -= SharingSettings.ViewDistanceHysteresis;
+	}
+
+	const auto MinViewDistanceSquared{FMath::Square(FMath::Max(0.0f, MinViewDistance))};
+	const auto Location{Character->GetActorLocation()};
+
+	for (const auto& ViewLocation : ViewLocations)
+	{
+		if (FVector::DistSquared(ViewLocation, Location) < MinViewDistanceSquared)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool UAlsAnimationSharingSubsystem::TryGetSharingKey(const AAlsCharacter* Character, FAlsAnimationSharingKey& Key)
+{
+	const auto* Settings{Character->GetSettings()};
+
+	if (!IsValid(Settings) || !Settings->AnimationSharing.bEnabled || Character->GetLocomotionAction().IsValid())
+	{
+		return false;
+	}
+
+	const auto* Mesh{Character->GetMesh()};
+	const auto* AnimationInstance{Mesh->GetAnimInstance()};
+
+	// Followers don't update their animation instances, so montages would not play on them, and
+	// the mesh rotation synchronization, used along with the absolute mesh rotation, would not work.
+
+	if (!IsValid(Mesh->GetSkinnedAsset()) || !IsValid(AnimationInstance) ||
+	    AnimationInstance->IsAnyMontagePlaying() || Mesh->IsUsingAbsoluteRotation())
+	{
+		return false;
+	}
+
+	Key.SkinnedAsset = Mesh->GetSkinnedAsset();
+	Key.AnimationInstanceClass = AnimationInstance->GetClass();
+
+	Key.LocomotionMode = Character->GetLocomotionMode();
+	Key.RotationMode = Character->GetRotationMode();
+	Key.Stance = Character->GetStance();
+	Key.Gait = Character->GetGait();
+	Key.OverlayMode = Character->GetOverlayMode();
+
+	const auto& SharingSettings{Settings->AnimationSharing};
+	const auto& LocomotionState{Character->GetLocomotionState()};
+
+	Key.SpeedBucket = FMath::FloorToInt32(LocomotionState.Speed / FMath::Max(1.0f, SharingSettings.SpeedBucketSize));
+
+	if (!LocomotionState.bHasVelocity)
+	{
+		Key.DirectionBucket = INDEX_NONE;
+		return true;
+	}
+
+	const auto DirectionBucketsCount{FMath::Max(1, SharingSettings.DirectionBucketsCount)};
+
+	const auto RelativeVelocityYawAngle{
+		FRotator3f::NormalizeAxis(LocomotionState.VelocityYawAngle - UE_REAL_TO_FLOAT(Character->GetActorRotation().Yaw))
+	};
+
+	Key.DirectionBucket = FMath::RoundToInt32(RelativeVelocityYawAngle / (360.0f / DirectionBucketsCount));
+	Key.DirectionBucket = (Key.DirectionBucket % DirectionBucketsCount + DirectionBucketsCount) % DirectionBucketsCount;
+
+	return true;
+}
+
+bool UAlsAnimationSharingSubsystem::CanLead(const AAlsCharacter* Character)
+{
+	// Depending on the visibility based animation tick option, the mesh may stop ticking its pose when it's not rendered,
+	// and in this case the followers, which may still be rendered, would be stuck with the last ticked pose.
+
+	const auto* Mesh{Character->GetMesh()};
+
+	return Mesh->VisibilityBasedAnimTickOption <= EVisibilityBasedAnimTickOption::AlwaysTickPose || Mesh->WasRecentlyRendered();
+}
+
+void UAlsAnimationSharingSubsystem::SetLeader(FAlsAnimationSharingCharacter& SharingCharacter, AAlsCharacter* NewLeader)
+{
+	if (IsValid(NewLeader) ? SharingCharacter.Leader == NewLeader : SharingCharacter.Leader.IsExplicitlyNull())
+	{
+		return;
+	}
+
+	auto* Mesh{SharingCharacter.Character->GetMesh()};
+
+	if (IsValid(NewLeader))
+	{
+		INC_DWORD_STAT(STAT_AlsAnimationSharingLeaderChanges)
+
+		SharingCharacter.Leader = NewLeader;
+
+		// The follower copies the component space pose, so its own mesh transform is preserved.
+
+		Mesh->SetLeaderPoseComponent(NewLeader->GetMesh());
+		return;
+	}
+
+	SharingCharacter.Leader.Reset();
+
+	Mesh->SetLeaderPoseComponent(nullptr);
+
+	// The animation instance was not updated while following another character, so its state is outdated.
+
+	auto* AnimationInstance{Cast<UAlsAnimationInstance>(Mesh->GetAnimInstance())};
+	if (IsValid(AnimationInstance))
+	{
+		AnimationInstance->MarkPendingUpdate();
+	}
+}
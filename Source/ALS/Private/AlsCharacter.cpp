@@ -1,6 +1,7 @@
 #include "AlsCharacter.h"
 
 #include "AlsAnimationInstance.h"
+#include "AlsAnimationSharingSubsystem.h"
 #include "AlsCharacterMovementComponent.h"
 #include "TimerManager.h"
 #include "Components/CapsuleComponent.h"
@@ -188,6 +189,26 @@ void AAlsCharacter::BeginPlay()
 	AlsCharacterMovement->SetRotationMode(RotationMode);
 
 	OnOverlayModeChanged(OverlayMode);
+
+	if (IsValid(Settings) && Settings->AnimationSharing.bEnabled)
+	{
+		auto* AnimationSharing{GetWorld()->GetSubsystem<UAlsAnimationSharingSubsystem>()};
+		if (IsValid(AnimationSharing))
+		{
+			AnimationSharing->AddCharacter(this);
+		}
+	}
+}
+
+void AAlsCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	auto* AnimationSharing{GetWorld()->GetSubsystem<UAlsAnimationSharingSubsystem>()};
+	if (IsValid(AnimationSharing))
+	{
+		AnimationSharing->RemoveCharacter(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AAlsCharacter::CalcCamera(const float DeltaTime, FMinimalViewInfo& ViewInfo)
@@ -1642,7 +1663,7 @@ void AAlsCharacter::RefreshGroundedRotation(const float DeltaTime)
 		else
 		{
 			TargetYawAngle = UE_REAL_TO_FLOAT(
-				ViewState.Rotation.Yaw + GetMesh()->GetAnimInstance()->GetCurveValue(UAlsConstants::RotationYawOffsetCurveName()));
+				ViewState.Rotation.Yaw + GetRotationAnimationCurveValue(UAlsConstants::RotationYawOffsetCurveName()));
 		}
 
 		const auto RotationInterpolationSpeed{CalculateGroundedMovingRotationInterpolationSpeed()};
@@ -1795,9 +1816,25 @@ float AAlsCharacter::CalculateGroundedMovingRotationInterpolationSpeed() const
 	                                                  ViewState.YawSpeed / ReferenceViewYawSpeed);
 }
 
+float AAlsCharacter::GetRotationAnimationCurveValue(const FName& CurveName) const
+{
+	// While the character copies the pose of another character through animation sharing, its own animation
+	// instance is not updated, so its curves are stale and are read from the animation instance of the leader.
+
+	const auto* LeaderMesh{Cast<USkeletalMeshComponent>(GetMesh()->LeaderPoseComponent.Get())};
+	const auto* AnimationInstance{IsValid(LeaderMesh) ? LeaderMesh->GetAnimInstance() : nullptr};
+
+	if (!IsValid(AnimationInstance))
+	{
+		AnimationInstance = GetMesh()->GetAnimInstance();
+	}
+
+	return AnimationInstance->GetCurveValue(CurveName);
+}
+
 void AAlsCharacter::ApplyRotationYawSpeedAnimationCurve(const float DeltaTime)
 {
-	const auto DeltaYawAngle{GetMesh()->GetAnimInstance()->GetCurveValue(UAlsConstants::RotationYawSpeedCurveName()) * DeltaTime};
+	const auto DeltaYawAngle{GetRotationAnimationCurveValue(UAlsConstants::RotationYawSpeedCurveName()) * DeltaTime};
 	if (FMath::Abs(DeltaYawAngle) > UE_SMALL_NUMBER)
 	{
 		auto NewRotation{GetActorRotation()};
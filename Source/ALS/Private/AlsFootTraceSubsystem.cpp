@@ -0,0 +1,129 @@
+#include "AlsFootTraceSubsystem.h"
+
+#include "Engine/World.h"
+#include "Utility/AlsUtility.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsFootTraceSubsystem)
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Async Foot Traces"), STAT_AlsAsyncFootTraces, STATGROUP_Als)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Async Foot Trace Misses"), STAT_AlsAsyncFootTraceMisses, STATGROUP_Als)
+
+TStatId UAlsFootTraceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAlsFootTraceSubsystem, STATGROUP_Tickables);
+}
+
+void UAlsFootTraceSubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	auto* World{GetWorld()};
+
+	FScopeLock Lock{&TracesCriticalSection};
+
+	for (auto Iterator{Traces.CreateIterator()}; Iterator; ++Iterator)
+	{
+		auto& Trace{Iterator.Value()};
+
+		// Forget about feet that are no longer traced, for example, because their characters have been destroyed.
+
+		static constexpr auto MaxUnusedFramesCount{10};
+
+		if (GFrameCounter - Trace.RequestFrameNumber > MaxUnusedFramesCount)
+		{
+			Iterator.RemoveCurrent();
+			continue;
+		}
+
+		if (Trace.TraceHandle.IsValid())
+		{
+			FTraceDatum TraceDatum;
+
+			if (World->QueryTraceData(Trace.TraceHandle, TraceDatum))
+			{
+				Trace.Hit = !TraceDatum.OutHits.IsEmpty() ? TraceDatum.OutHits[0] : FHitResult{TraceDatum.Start, TraceDatum.End};
+				Trace.bHitValid = true;
+			}
+
+			Trace.TraceHandle = {};
+		}
+
+		if (Trace.bRequestPending)
+		{
+			INC_DWORD_STAT(STAT_AlsAsyncFootTraces)
+
+			static const FName QueryTag{FString::Printf(TEXT("%hs"), __FUNCTION__)};
+
+			FCollisionQueryParams QueryParameters{QueryTag, true, Trace.IgnoredActor.Get()};
+			QueryParameters.bReturnPhysicalMaterial = true;
+
+			Trace.TraceHandle = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Trace.TraceStart, Trace.TraceEnd,
+			                                                   Trace.TraceChannel, QueryParameters);
+			Trace.bRequestPending = false;
+		}
+	}
+}
+
+bool UAlsFootTraceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UAlsFootTraceSubsystem::TryGetFootTraceHit(const USceneComponent* Component, const EAlsFootBone FootBone,
+                                                const FVector& TraceStart, const FVector& TraceEnd,
+                                                const ECollisionChannel TraceChannel, const AActor* IgnoredActor,
+                                                const float MaxExtrapolationDistance, FHitResult& Hit)
+{
+	FScopeLock Lock{&TracesCriticalSection};
+
+	auto& Trace{Traces.FindOrAdd({Component, FootBone})};
+
+	Trace.TraceStart = TraceStart;
+	Trace.TraceEnd = TraceEnd;
+	Trace.TraceChannel = TraceChannel;
+	Trace.IgnoredActor = IgnoredActor;
+	Trace.RequestFrameNumber = GFrameCounter;
+	Trace.bRequestPending = true;
+
+	if (!Trace.bHitValid || FVector::DistSquared(Trace.Hit.TraceStart, TraceStart) > FMath::Square(MaxExtrapolationDistance))
+	{
+		INC_DWORD_STAT(STAT_AlsAsyncFootTraceMisses)
+		return false;
+	}
+
+	if (!Trace.Hit.bBlockingHit)
+	{
+		Hit = FHitResult{TraceStart, TraceEnd};
+		return true;
+	}
+
+	// Since the previous trace, the foot has moved by its velocity multiplied by the frame time. Extrapolate the hit by assuming that the
+	// surface is flat around it and intersecting the current trace with the plane defined by the previous impact point and normal.
+
+	const auto TraceDirection{TraceEnd - TraceStart};
+	const auto TraceDirectionDotNormal{TraceDirection | Trace.Hit.ImpactNormal};
+
+	if (FMath::Abs(TraceDirectionDotNormal) <= UE_KINDA_SMALL_NUMBER)
+	{
+		INC_DWORD_STAT(STAT_AlsAsyncFootTraceMisses)
+		return false;
+	}
+
+	const auto HitTime{((Trace.Hit.ImpactPoint - TraceStart) | Trace.Hit.ImpactNormal) / TraceDirectionDotNormal};
+
+	if (HitTime < 0.0f || HitTime > 1.0f)
+	{
+		INC_DWORD_STAT(STAT_AlsAsyncFootTraceMisses)
+		return false;
+	}
+
+	Hit = Trace.Hit;
+	Hit.TraceStart = TraceStart;
+	Hit.TraceEnd = TraceEnd;
+	Hit.Time = UE_REAL_TO_FLOAT(HitTime);
+	Hit.Distance = UE_REAL_TO_FLOAT(TraceDirection.Size() * HitTime);
+	Hit.ImpactPoint = TraceStart + TraceDirection * HitTime;
+	Hit.Location = Hit.ImpactPoint;
+
+	return true;
+}
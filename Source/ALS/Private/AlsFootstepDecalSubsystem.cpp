@@ -0,0 +1,233 @@
+#include "AlsFootstepDecalSubsystem.h"
+
+#include "Camera/PlayerCameraManager.h"
+#include "Components/DecalComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/WorldSettings.h"
+#include "Notifies/AlsAnimNotify_FootstepEffects.h"
+#include "Utility/AlsUtility.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsFootstepDecalSubsystem)
+
+static TAutoConsoleVariable<int32> CVarFootstepDecalPoolCapacity(
+	TEXT("ALS.FootstepDecals.PoolCapacity"),
+	100,
+	TEXT("Maximum number of footstep decal components per world. When exceeded, the oldest decal is reused."));
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Footstep Decal Spawns"), STAT_AlsFootstepDecalSpawns, STATGROUP_Als)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Footstep Decal Recycles"), STAT_AlsFootstepDecalRecycles, STATGROUP_Als)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Footstep Decal Distance Culls"), STAT_AlsFootstepDecalDistanceCulls, STATGROUP_Als)
+
+TStatId UAlsFootstepDecalSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAlsFootstepDecalSubsystem, STATGROUP_Tickables);
+}
+
+void UAlsFootstepDecalSubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (VisibleDecalsCount <= 0)
+	{
+		return;
+	}
+
+	// Hide completely faded decals and detach them so that they don't keep their attach parents alive.
+
+	const auto WorldTime{GetWorld()->GetTimeSeconds()};
+
+	VisibleDecalsCount = 0;
+
+	for (auto& PooledDecal : Decals)
+	{
+		if (!IsValid(PooledDecal.Decal) || !PooledDecal.Decal->IsVisible())
+		{
+			continue;
+		}
+
+		if (PooledDecal.ExpirationTime > WorldTime)
+		{
+			VisibleDecalsCount += 1;
+			continue;
+		}
+
+		PooledDecal.Decal->SetVisibility(false);
+		PooledDecal.Decal->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+	}
+}
+
+void UAlsFootstepDecalSubsystem::Deinitialize()
+{
+	for (const auto& PooledDecal : Decals)
+	{
+		if (IsValid(PooledDecal.Decal))
+		{
+			PooledDecal.Decal->DestroyComponent();
+		}
+	}
+
+	Decals.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UAlsFootstepDecalSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+UDecalComponent* UAlsFootstepDecalSubsystem::SpawnDecal(const FAlsFootstepDecalSettings& DecalSettings, UMaterialInterface* DecalMaterial,
+                                                        const EPhysicalSurface SurfaceType, const FVector& Size, const FVector& Location,
+                                                        const FRotator& Rotation, USceneComponent* AttachParent)
+{
+	if (!IsWithinSpawnDistance(Location, DecalSettings.MaxSpawnDistance))
+	{
+		INC_DWORD_STAT(STAT_AlsFootstepDecalDistanceCulls)
+		return nullptr;
+	}
+
+	const auto Capacity{FMath::Max(1, CVarFootstepDecalPoolCapacity.GetValueOnGameThread())};
+
+	while (Decals.Num() > Capacity)
+	{
+		if (IsValid(Decals.Last().Decal))
+		{
+			Decals.Last().Decal->DestroyComponent();
+		}
+
+		Decals.Pop(EAllowShrinking::No);
+	}
+
+	if (Decals.Num() < Capacity)
+	{
+		Decals.SetNum(Capacity);
+	}
+
+	NextDecalIndex %= Decals.Num();
+
+	const auto WorldTime{GetWorld()->GetTimeSeconds()};
+
+	auto DecalIndex{FindDecalIndexForSurface(SurfaceType, DecalSettings.MaxCount, WorldTime)};
+
+	if (DecalIndex == INDEX_NONE)
+	{
+		DecalIndex = NextDecalIndex;
+		NextDecalIndex = (NextDecalIndex + 1) % Decals.Num();
+	}
+
+	auto& PooledDecal{Decals[DecalIndex]};
+
+	if (IsValid(PooledDecal.Decal))
+	{
+		INC_DWORD_STAT(STAT_AlsFootstepDecalRecycles)
+
+		if (!PooledDecal.Decal->IsVisible())
+		{
+			PooledDecal.Decal->SetVisibility(true);
+			VisibleDecalsCount += 1;
+		}
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_AlsFootstepDecalSpawns)
+
+		PooledDecal.Decal = NewObject<UDecalComponent>(GetWorld()->GetWorldSettings());
+		PooledDecal.Decal->bAllowAnyoneToDestroyMe = true;
+		PooledDecal.Decal->SetUsingAbsoluteScale(true);
+		PooledDecal.Decal->RegisterComponentWithWorld(GetWorld());
+
+		VisibleDecalsCount += 1;
+	}
+
+	auto* Decal{PooledDecal.Decal.Get()};
+
+	PooledDecal.SurfaceType = SurfaceType;
+	PooledDecal.ExpirationTime = WorldTime + DecalSettings.Duration + DecalSettings.FadeOutDuration;
+
+	if (IsValid(AttachParent))
+	{
+		Decal->AttachToComponent(AttachParent, FAttachmentTransformRules::KeepWorldTransform);
+	}
+	else
+	{
+		Decal->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+	}
+
+	Decal->SetWorldLocationAndRotation(Location, Rotation);
+	Decal->SetDecalMaterial(DecalMaterial);
+	Decal->DecalSize = Size;
+
+	// Don't use UDecalComponent::SetFadeOut(), because it destroys the component once the fade out is complete.
+	// Fading is restarted when the render state is recreated, so mark it dirty even if nothing else has changed.
+
+	Decal->FadeStartDelay = DecalSettings.Duration;
+	Decal->FadeDuration = DecalSettings.FadeOutDuration;
+	Decal->MarkRenderStateDirty();
+
+	return Decal;
+}
+
+bool UAlsFootstepDecalSubsystem::IsWithinSpawnDistance(const FVector& Location, const float MaxDistance) const
+{
+	if (MaxDistance <= 0.0f)
+	{
+		return true;
+	}
+
+	auto bAnyLocalPlayer{false};
+
+	for (auto Iterator{GetWorld()->GetPlayerControllerIterator()}; Iterator; ++Iterator)
+	{
+		const auto* Player{Iterator->Get()};
+
+		if (!IsValid(Player) || !Player->IsLocalController() || !IsValid(Player->PlayerCameraManager))
+		{
+			continue;
+		}
+
+		if (FVector::DistSquared(Player->PlayerCameraManager->GetCameraLocation(), Location) <= FMath::Square(MaxDistance))
+		{
+			return true;
+		}
+
+		bAnyLocalPlayer = true;
+	}
+
+	// Don't cull anything if there is no one to cull for.
+
+	return !bAnyLocalPlayer;
+}
+
+int32 UAlsFootstepDecalSubsystem::FindDecalIndexForSurface(const EPhysicalSurface SurfaceType,
+                                                           const int32 MaxSurfaceDecalsCount, const double WorldTime) const
+{
+	if (MaxSurfaceDecalsCount <= 0)
+	{
+		return INDEX_NONE;
+	}
+
+	// Iterate from the oldest decal to the newest one, counting the live decals of the
+	// surface type. If there are too many of them, the oldest one will be reused.
+
+	auto SurfaceDecalsCount{0};
+	auto OldestSurfaceDecalIndex{INDEX_NONE};
+
+	for (auto i{0}; i < Decals.Num(); i++)
+	{
+		const auto Index{(NextDecalIndex + i) % Decals.Num()};
+		const auto& PooledDecal{Decals[Index]};
+
+		if (IsValid(PooledDecal.Decal) && PooledDecal.SurfaceType == SurfaceType && PooledDecal.ExpirationTime > WorldTime)
+		{
+			if (OldestSurfaceDecalIndex == INDEX_NONE)
+			{
+				OldestSurfaceDecalIndex = Index;
+			}
+
+			SurfaceDecalsCount += 1;
+		}
+	}
+
+	return SurfaceDecalsCount >= MaxSurfaceDecalsCount ? OldestSurfaceDecalIndex : INDEX_NONE;
+}
@@ -0,0 +1,333 @@
+#include "AlsFootstepEffectsSubsystem.h"
+
+#include "Camera/PlayerCameraManager.h"
+#include "Components/AudioComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/WorldSettings.h"
+#include "Notifies/AlsAnimNotify_FootstepEffects.h"
+#include "Utility/AlsUtility.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsFootstepEffectsSubsystem)
+
+static TAutoConsoleVariable<int32> CVarFootstepsMaxPerFrame(
+	TEXT("ALS.Footsteps.MaxPerFrame"),
+	16,
+	TEXT("Maximum number of footsteps per frame that are allowed to spawn effects. Footsteps of locally controlled player characters\n")
+	TEXT("are not limited by this budget. If zero is specified, the number of footsteps is not limited."));
+
+static TAutoConsoleVariable<int32> CVarFootstepAudioPoolCapacity(
+	TEXT("ALS.Footsteps.AudioPoolCapacity"),
+	32,
+	TEXT("Maximum number of footstep audio components per world. When exceeded, the footstep sound farthest from the local audio listeners\n")
+	TEXT("is stopped and reused, or the oldest one if there are no listeners."));
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Footstep Significance Culls"), STAT_AlsFootstepSignificanceCulls, STATGROUP_Als)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Footstep Budget Culls"), STAT_AlsFootstepBudgetCulls, STATGROUP_Als)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Footstep Audio Component Spawns"), STAT_AlsFootstepAudioComponentSpawns, STATGROUP_Als)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Footstep Audio Component Steals"), STAT_AlsFootstepAudioComponentSteals, STATGROUP_Als)
+
+void UAlsFootstepEffectsSubsystem::Deinitialize()
+{
+	for (const auto& PooledAudioComponent : AudioComponents)
+	{
+		if (IsValid(PooledAudioComponent.AudioComponent))
+		{
+			PooledAudioComponent.AudioComponent->DestroyComponent();
+		}
+	}
+
+	AudioComponents.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UAlsFootstepEffectsSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+FAlsFootstepSignificance UAlsFootstepEffectsSubsystem::EvaluateFootstepSignificance(const USkeletalMeshComponent* Mesh,
+                                                                                    const FVector& FootstepLocation,
+                                                                                    const FAlsFootstepSignificanceSettings& SignificanceSettings)
+{
+	RefreshFrame();
+
+	FAlsFootstepSignificance Significance;
+
+	if (Viewers.IsEmpty())
+	{
+		// There is no local player to cull the footstep for.
+		return Significance;
+	}
+
+	const auto* Pawn{Cast<APawn>(Mesh->GetOwner())};
+
+	if (SignificanceSettings.bAlwaysSignificantForLocalPlayer && IsValid(Pawn) &&
+	    Pawn->IsLocallyControlled() && Pawn->IsPlayerControlled())
+	{
+		FrameFootstepsCount += 1;
+		return Significance;
+	}
+
+	const auto MaxFootstepsCount{CVarFootstepsMaxPerFrame.GetValueOnGameThread()};
+
+	if (MaxFootstepsCount > 0 && FrameFootstepsCount >= MaxFootstepsCount)
+	{
+		INC_DWORD_STAT(STAT_AlsFootstepBudgetCulls)
+
+		Significance.bSound = false;
+		Significance.bDecal = false;
+		Significance.bParticleSystem = false;
+		return Significance;
+	}
+
+	auto ListenerDistanceSquared{TNumericLimits<double>::Max()};
+	auto ViewDistanceSquared{TNumericLimits<double>::Max()};
+	auto ScreenSize{0.0f};
+
+	const auto& MeshBounds{Mesh->Bounds};
+
+	for (const auto& Viewer : Viewers)
+	{
+		ListenerDistanceSquared = FMath::Min(ListenerDistanceSquared, FVector::DistSquared(Viewer.ListenerLocation, FootstepLocation));
+		ViewDistanceSquared = FMath::Min(ViewDistanceSquared, FVector::DistSquared(Viewer.ViewLocation, FootstepLocation));
+
+		// Rough estimate of the fraction of the screen width occupied by the bounding sphere of the mesh.
+
+		const auto BoundsDistance{FVector::Dist(Viewer.ViewLocation, MeshBounds.Origin)};
+
+		ScreenSize = FMath::Max(ScreenSize, BoundsDistance > MeshBounds.SphereRadius
+			                                     ? static_cast<float>(MeshBounds.SphereRadius / (BoundsDistance * Viewer.ViewHalfFovTangent))
+			                                     : 1.0f);
+	}
+
+	Significance.bSound = SignificanceSettings.MaxSoundDistance <= 0.0f ||
+	                      ListenerDistanceSquared <= FMath::Square(SignificanceSettings.MaxSoundDistance);
+
+	const auto bLargeEnoughOnScreen{SignificanceSettings.MinScreenSize <= 0.0f || ScreenSize >= SignificanceSettings.MinScreenSize};
+
+	Significance.bDecal = bLargeEnoughOnScreen &&
+	                      (SignificanceSettings.MaxDecalDistance <= 0.0f ||
+	                       ViewDistanceSquared <= FMath::Square(SignificanceSettings.MaxDecalDistance));
+
+	// Decals stay in the world after the character has left, but particle systems
+	// are short-lived, so don't spawn them if the character is not being rendered.
+
+	Significance.bParticleSystem = bLargeEnoughOnScreen && Mesh->WasRecentlyRendered() &&
+	                               (SignificanceSettings.MaxParticleSystemDistance <= 0.0f ||
+	                                ViewDistanceSquared <= FMath::Square(SignificanceSettings.MaxParticleSystemDistance));
+
+	if (Significance.IsAnySignificant())
+	{
+		FrameFootstepsCount += 1;
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_AlsFootstepSignificanceCulls)
+	}
+
+	return Significance;
+}
+
+UAudioComponent* UAlsFootstepEffectsSubsystem::AcquireAudioComponent(USceneComponent* AttachParent, const FName AttachSocketName,
+                                                                     const FVector& Location, const FRotator& Rotation)
+{
+	const auto Capacity{FMath::Max(1, CVarFootstepAudioPoolCapacity.GetValueOnGameThread())};
+
+	while (AudioComponents.Num() > Capacity)
+	{
+		if (IsValid(AudioComponents.Last().AudioComponent))
+		{
+			AudioComponents.Last().AudioComponent->DestroyComponent();
+		}
+
+		AudioComponents.Pop(EAllowShrinking::No);
+	}
+
+	auto AudioComponentIndex{
+		AudioComponents.IndexOfByPredicate([](const FAlsFootstepAudioComponent& PooledAudioComponent)
+		{
+			return !IsValid(PooledAudioComponent.AudioComponent) || !PooledAudioComponent.AudioComponent->IsPlaying();
+		})
+	};
+
+	if (AudioComponentIndex == INDEX_NONE)
+	{
+		if (AudioComponents.Num() < Capacity)
+		{
+			AudioComponentIndex = AudioComponents.AddDefaulted();
+		}
+		else
+		{
+			INC_DWORD_STAT(STAT_AlsFootstepAudioComponentSteals)
+
+			// The listener locations are used to choose which footstep sound to cut off.
+
+			RefreshFrame();
+
+			AudioComponentIndex = FindAudioComponentToSteal();
+		}
+	}
+
+	auto& PooledAudioComponent{AudioComponents[AudioComponentIndex]};
+	auto& AudioComponent{PooledAudioComponent.AudioComponent};
+
+	if (!IsValid(AudioComponent))
+	{
+		INC_DWORD_STAT(STAT_AlsFootstepAudioComponentSpawns)
+
+		AudioComponent = NewObject<UAudioComponent>(GetWorld()->GetWorldSettings());
+		AudioComponent->bAutoActivate = false;
+		AudioComponent->bAutoDestroy = false;
+		AudioComponent->bAllowSpatialization = true;
+		AudioComponent->OnAudioFinishedNative.AddUObject(this, &ThisClass::OnAudioFinished);
+		AudioComponent->RegisterComponentWithWorld(GetWorld());
+	}
+	else if (AudioComponent->IsPlaying())
+	{
+		AudioComponent->Stop();
+	}
+
+	PooledAudioComponent.AcquireTime = GetWorld()->GetTimeSeconds();
+
+	if (IsValid(AttachParent))
+	{
+		AudioComponent->AttachToComponent(AttachParent, FAttachmentTransformRules::SnapToTargetNotIncludingScale, AttachSocketName);
+		AudioComponent->SetRelativeLocationAndRotation(Location, Rotation);
+
+		// The audio component is owned by the world settings, so it would keep playing detached
+		// at its last location if the attach parent was destroyed, unless it is stopped explicitly.
+
+		auto* AttachParentOwner{AttachParent->GetOwner()};
+
+		if (IsValid(AttachParentOwner))
+		{
+			AttachParentOwner->OnDestroyed.AddUniqueDynamic(this, &ThisClass::OnAttachParentOwnerDestroyed);
+		}
+	}
+	else
+	{
+		AudioComponent->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+		AudioComponent->SetWorldLocationAndRotation(Location, Rotation);
+	}
+
+	return AudioComponent;
+}
+
+void UAlsFootstepEffectsSubsystem::RefreshFrame()
+{
+	if (ViewersFrameNumber != GFrameCounter)
+	{
+		ViewersFrameNumber = GFrameCounter;
+		FrameFootstepsCount = 0;
+
+		RefreshViewers();
+	}
+}
+
+void UAlsFootstepEffectsSubsystem::RefreshViewers()
+{
+	Viewers.Reset();
+
+	for (auto Iterator{GetWorld()->GetPlayerControllerIterator()}; Iterator; ++Iterator)
+	{
+		const auto* Player{Iterator->Get()};
+
+		if (!IsValid(Player) || !Player->IsLocalController() || !IsValid(Player->PlayerCameraManager))
+		{
+			continue;
+		}
+
+		auto& Viewer{Viewers.Emplace_GetRef()};
+
+		FVector ListenerFrontDirection;
+		FVector ListenerRightDirection;
+		Player->GetAudioListenerPosition(Viewer.ListenerLocation, ListenerFrontDirection, ListenerRightDirection);
+
+		Viewer.ViewLocation = Player->PlayerCameraManager->GetCameraLocation();
+		Viewer.ViewHalfFovTangent = FMath::Max(KINDA_SMALL_NUMBER, FMath::Tan(FMath::DegreesToRadians(
+			                                       Player->PlayerCameraManager->GetFOVAngle() * 0.5f)));
+	}
+}
+
+int32 UAlsFootstepEffectsSubsystem::FindAudioComponentToSteal() const
+{
+	// Cut off the footstep sound that is least likely to be noticed: the one farthest from the local
+	// audio listeners or, if there are no listeners or the distances are equal, the oldest one.
+
+	auto StealIndex{0};
+	auto StealListenerDistanceSquared{-1.0};
+	auto StealAcquireTime{TNumericLimits<double>::Max()};
+
+	for (auto i{0}; i < AudioComponents.Num(); i++)
+	{
+		const auto& PooledAudioComponent{AudioComponents[i]};
+
+		auto ListenerDistanceSquared{0.0};
+
+		if (!Viewers.IsEmpty())
+		{
+			const auto Location{PooledAudioComponent.AudioComponent->GetComponentLocation()};
+
+			ListenerDistanceSquared = TNumericLimits<double>::Max();
+
+			for (const auto& Viewer : Viewers)
+			{
+				ListenerDistanceSquared = FMath::Min(ListenerDistanceSquared, FVector::DistSquared(Viewer.ListenerLocation, Location));
+			}
+		}
+
+		if (ListenerDistanceSquared > StealListenerDistanceSquared ||
+		    (ListenerDistanceSquared == StealListenerDistanceSquared && PooledAudioComponent.AcquireTime < StealAcquireTime))
+		{
+			StealIndex = i;
+			StealListenerDistanceSquared = ListenerDistanceSquared;
+			StealAcquireTime = PooledAudioComponent.AcquireTime;
+		}
+	}
+
+	return StealIndex;
+}
+
+void UAlsFootstepEffectsSubsystem::OnAudioFinished(UAudioComponent* AudioComponent)
+{
+	// The audio component may have already been reused for another footstep by the time this is called.
+
+	if (!IsValid(AudioComponent) || AudioComponent->IsPlaying())
+	{
+		return;
+	}
+
+	auto* AttachParentOwner{AudioComponent->GetAttachParentActor()};
+
+	// Don't keep the attach parent alive while the audio component is idle in the pool.
+
+	AudioComponent->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+
+	if (IsValid(AttachParentOwner) &&
+	    !AudioComponents.ContainsByPredicate([AttachParentOwner](const FAlsFootstepAudioComponent& PooledAudioComponent)
+	    {
+		    return IsValid(PooledAudioComponent.AudioComponent) &&
+		           PooledAudioComponent.AudioComponent->GetAttachParentActor() == AttachParentOwner;
+	    }))
+	{
+		AttachParentOwner->OnDestroyed.RemoveDynamic(this, &ThisClass::OnAttachParentOwnerDestroyed);
+	}
+}
+
+void UAlsFootstepEffectsSubsystem::OnAttachParentOwnerDestroyed(AActor* DestroyedActor)
+{
+	for (const auto& PooledAudioComponent : AudioComponents)
+	{
+		if (IsValid(PooledAudioComponent.AudioComponent) &&
+		    PooledAudioComponent.AudioComponent->GetAttachParentActor() == DestroyedActor)
+		{
+			PooledAudioComponent.AudioComponent->Stop();
+			PooledAudioComponent.AudioComponent->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+		}
+	}
+}
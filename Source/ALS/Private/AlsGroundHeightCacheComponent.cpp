@@ -0,0 +1,329 @@
+#include "AlsGroundHeightCacheComponent.h"
+
+#include "DrawDebugHelpers.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+#include "Utility/AlsConstants.h"
+#include "Utility/AlsDebugUtility.h"
+#include "Utility/AlsUtility.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsGroundHeightCacheComponent)
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ground Height Cache Sample Traces"), STAT_AlsGroundHeightCacheSampleTraces, STATGROUP_Als)
+
+UAlsGroundHeightCacheComponent::UAlsGroundHeightCacheComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+}
+
+void UAlsGroundHeightCacheComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	ResetSamples();
+}
+
+void UAlsGroundHeightCacheComponent::TickComponent(const float DeltaTime, const ELevelTick TickType,
+                                                   FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (Samples.Num() != FMath::Square(GridSize))
+	{
+		ResetSamples();
+	}
+
+	const auto TraceOrigin{GetTraceOrigin()};
+
+	{
+		FWriteScopeLock Lock{SamplesLock};
+
+		CenterCell.X = FMath::RoundToInt32(TraceOrigin.X / CellSize);
+		CenterCell.Y = FMath::RoundToInt32(TraceOrigin.Y / CellSize);
+
+		InvalidateMovedSamples();
+	}
+
+	RefreshSamples(TraceOrigin);
+
+#if ENABLE_DRAW_DEBUG
+	if (UAlsDebugUtility::ShouldDisplayDebugForActor(GetOwner(), UAlsConstants::TracesDebugDisplayName()))
+	{
+		ValidateSamples(TraceOrigin);
+		DrawDebug(TraceOrigin);
+	}
+#endif
+}
+
+bool UAlsGroundHeightCacheComponent::TryGetGround(const FVector& Location, FHitResult& Hit) const
+{
+	FReadScopeLock Lock{SamplesLock};
+
+	return TryGetGroundUnsafe(Location, Hit);
+}
+
+void UAlsGroundHeightCacheComponent::ResetSamples()
+{
+	FWriteScopeLock Lock{SamplesLock};
+
+	Samples.Reset();
+	Samples.SetNum(FMath::Square(GridSize));
+
+	SampledMovableComponents.Reset();
+
+	const auto MinOffset{-GridSize / 2};
+
+	CellOffsetsByDistance.Reset(Samples.Num());
+
+	for (auto Y{MinOffset}; Y < MinOffset + GridSize; Y++)
+	{
+		for (auto X{MinOffset}; X < MinOffset + GridSize; X++)
+		{
+			CellOffsetsByDistance.Emplace(X, Y);
+		}
+	}
+
+	CellOffsetsByDistance.StableSort([](const FIntPoint& A, const FIntPoint& B)
+	{
+		return A.SizeSquared() < B.SizeSquared();
+	});
+}
+
+int32 UAlsGroundHeightCacheComponent::GetSampleIndex(const FIntPoint& Cell) const
+{
+	// The grid is a toroidal buffer, so that moving the grid center doesn't require moving any samples.
+
+	const auto X{(Cell.X % GridSize + GridSize) % GridSize};
+	const auto Y{(Cell.Y % GridSize + GridSize) % GridSize};
+
+	return X + Y * GridSize;
+}
+
+FVector UAlsGroundHeightCacheComponent::GetTraceOrigin() const
+{
+	const auto* Character{Cast<ACharacter>(GetOwner())};
+
+	if (IsValid(Character))
+	{
+		return Character->GetActorLocation() - Character->GetActorUpVector() *
+		       Character->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+	}
+
+	return GetOwner()->GetActorLocation();
+}
+
+void UAlsGroundHeightCacheComponent::InvalidateMovedSamples()
+{
+	for (auto Iterator{SampledMovableComponents.CreateIterator()}; Iterator; ++Iterator)
+	{
+		const auto* Component{Iterator.Key().Get()};
+
+		if (IsValid(Component) && Component->GetComponentTransform().Equals(Iterator.Value()))
+		{
+			continue;
+		}
+
+		for (auto& Sample : Samples)
+		{
+			if (Sample.Component == Iterator.Key())
+			{
+				Sample.bValid = false;
+			}
+		}
+
+		Iterator.RemoveCurrent();
+	}
+}
+
+void UAlsGroundHeightCacheComponent::RefreshSamples(const FVector& TraceOrigin)
+{
+	static const FName TraceTag{FString::Printf(TEXT("%hs"), __FUNCTION__)};
+
+	FCollisionQueryParams QueryParameters{TraceTag, false, GetOwner()};
+	QueryParameters.bReturnPhysicalMaterial = true;
+
+	auto SampleTracesCount{0};
+
+	// Resample the cells that have entered the grid, starting from the ones closest to the grid center. Since only
+	// the game thread writes samples, they can be read here without a lock, but must be written with it.
+
+	for (const auto& CellOffset : CellOffsetsByDistance)
+	{
+		if (SampleTracesCount >= MaxSampleTracesPerFrame)
+		{
+			break;
+		}
+
+		const auto Cell{CenterCell + CellOffset};
+		const auto SampleIndex{GetSampleIndex(Cell)};
+		const auto& Sample{Samples[SampleIndex]};
+
+		// Samples that didn't hit anything may hit something if the owning actor has moved up or down since they were traced.
+
+		if (Sample.bValid && Sample.Cell == Cell &&
+		    (Sample.bBlockingHit || FMath::Abs(Sample.TraceOriginZ - TraceOrigin.Z) <= CellSize))
+		{
+			continue;
+		}
+
+		const FVector SampleLocation{Cell.X * CellSize, Cell.Y * CellSize, TraceOrigin.Z};
+
+		FHitResult Hit;
+		GetWorld()->LineTraceSingleByChannel(Hit, SampleLocation + FVector{0.0f, 0.0f, TraceDistanceUpward},
+		                                     SampleLocation - FVector{0.0f, 0.0f, TraceDistanceDownward},
+		                                     TraceChannel, QueryParameters);
+
+		SampleTracesCount += 1;
+
+		INC_DWORD_STAT(STAT_AlsGroundHeightCacheSampleTraces)
+
+		FWriteScopeLock Lock{SamplesLock};
+
+		auto& NewSample{Samples[SampleIndex]};
+
+		NewSample.Cell = Cell;
+		NewSample.ImpactPoint = Hit.ImpactPoint;
+		NewSample.ImpactNormal = Hit.ImpactNormal;
+		NewSample.Component = Hit.Component;
+		NewSample.PhysicalMaterial = Hit.PhysMaterial;
+		NewSample.TraceOriginZ = TraceOrigin.Z;
+		NewSample.bValid = true;
+		NewSample.bBlockingHit = Hit.bBlockingHit;
+
+		if (Hit.Component.IsValid() && Hit.Component->Mobility == EComponentMobility::Movable &&
+		    !SampledMovableComponents.Contains(Hit.Component))
+		{
+			SampledMovableComponents.Add(Hit.Component, Hit.Component->GetComponentTransform());
+		}
+	}
+
+	DebugState.SampleTracesCount += SampleTracesCount;
+}
+
+bool UAlsGroundHeightCacheComponent::TryGetGroundUnsafe(const FVector& Location, FHitResult& Hit) const
+{
+	if (Samples.Num() != FMath::Square(GridSize))
+	{
+		return false;
+	}
+
+	const auto CellX{Location.X / CellSize};
+	const auto CellY{Location.Y / CellSize};
+
+	const FIntPoint Cell{FMath::FloorToInt32(CellX), FMath::FloorToInt32(CellY)};
+
+	const FAlsGroundHeightSample* CellSamples[]{
+		&Samples[GetSampleIndex(Cell)],
+		&Samples[GetSampleIndex(Cell + FIntPoint{1, 0})],
+		&Samples[GetSampleIndex(Cell + FIntPoint{0, 1})],
+		&Samples[GetSampleIndex(Cell + FIntPoint{1, 1})]
+	};
+
+	const FIntPoint CellSampleOffsets[]{{0, 0}, {1, 0}, {0, 1}, {1, 1}};
+
+	auto MinHeight{TNumericLimits<double>::Max()};
+	auto MaxHeight{TNumericLimits<double>::Lowest()};
+
+	for (auto i{0}; i < static_cast<int32>(UE_ARRAY_COUNT(CellSamples)); i++)
+	{
+		const auto& Sample{*CellSamples[i]};
+
+		if (!Sample.bValid || !Sample.bBlockingHit || Sample.Cell != Cell + CellSampleOffsets[i])
+		{
+			return false;
+		}
+
+		MinHeight = FMath::Min(MinHeight, Sample.ImpactPoint.Z);
+		MaxHeight = FMath::Max(MaxHeight, Sample.ImpactPoint.Z);
+	}
+
+	if (MaxHeight - MinHeight > MaxInterpolatedHeightDifference)
+	{
+		return false;
+	}
+
+	const auto AlphaX{CellX - Cell.X};
+	const auto AlphaY{CellY - Cell.Y};
+
+	const auto Height{
+		FMath::BiLerp(CellSamples[0]->ImpactPoint.Z, CellSamples[1]->ImpactPoint.Z,
+		              CellSamples[2]->ImpactPoint.Z, CellSamples[3]->ImpactPoint.Z, AlphaX, AlphaY)
+	};
+
+	const auto Normal{
+		FMath::BiLerp(CellSamples[0]->ImpactNormal, CellSamples[1]->ImpactNormal,
+		              CellSamples[2]->ImpactNormal, CellSamples[3]->ImpactNormal, AlphaX, AlphaY).GetSafeNormal()
+	};
+
+	// Take the component and physical material from the closest sample.
+
+	const auto& ClosestSample{*CellSamples[(AlphaX >= 0.5f ? 1 : 0) + (AlphaY >= 0.5f ? 2 : 0)]};
+
+	Hit.bBlockingHit = true;
+	Hit.ImpactPoint = {Location.X, Location.Y, Height};
+	Hit.Location = Hit.ImpactPoint;
+	Hit.ImpactNormal = Normal.IsZero() ? FVector::ZAxisVector : Normal;
+	Hit.Normal = Hit.ImpactNormal;
+	Hit.Component = ClosestSample.Component;
+	Hit.PhysMaterial = ClosestSample.PhysicalMaterial;
+
+	return true;
+}
+
+#if ENABLE_DRAW_DEBUG
+void UAlsGroundHeightCacheComponent::ValidateSamples(const FVector& TraceOrigin)
+{
+	// Compare the interpolated ground against a direct trace at a random location inside the grid.
+
+	const auto MaxOffset{(GridSize / 2 - 1) * CellSize};
+
+	const FVector Location{
+		TraceOrigin.X + FMath::FRandRange(-MaxOffset, MaxOffset),
+		TraceOrigin.Y + FMath::FRandRange(-MaxOffset, MaxOffset),
+		TraceOrigin.Z
+	};
+
+	FHitResult CachedHit;
+
+	if (!TryGetGround(Location, CachedHit))
+	{
+		return;
+	}
+
+	static const FName TraceTag{FString::Printf(TEXT("%hs"), __FUNCTION__)};
+
+	FHitResult Hit;
+	if (!GetWorld()->LineTraceSingleByChannel(Hit, Location + FVector{0.0f, 0.0f, TraceDistanceUpward},
+	                                          Location - FVector{0.0f, 0.0f, TraceDistanceDownward},
+	                                          TraceChannel, {TraceTag, false, GetOwner()}))
+	{
+		return;
+	}
+
+	const auto HeightError{UE_REAL_TO_FLOAT(FMath::Abs(Hit.ImpactPoint.Z - CachedHit.ImpactPoint.Z))};
+
+	DebugState.ValidationsCount += 1;
+	DebugState.AverageHeightError += (HeightError - DebugState.AverageHeightError) / DebugState.ValidationsCount;
+	DebugState.MaxHeightError = FMath::Max(DebugState.MaxHeightError, HeightError);
+}
+
+void UAlsGroundHeightCacheComponent::DrawDebug(const FVector& TraceOrigin) const
+{
+	const auto* World{GetWorld()};
+
+	for (const auto& Sample : Samples)
+	{
+		if (Sample.bValid && Sample.bBlockingHit)
+		{
+			DrawDebugPoint(World, Sample.ImpactPoint, 4.0f, FColor::Cyan, false, -1.0f, SDPG_World);
+		}
+	}
+
+	DrawDebugString(World, TraceOrigin, FString::Printf(TEXT("Sample Traces: %d\nValidations: %d\nAverage Error: %.2f cm\nMax Error: %.2f cm"),
+	                                                    DebugState.SampleTracesCount, DebugState.ValidationsCount,
+	                                                    DebugState.AverageHeightError, DebugState.MaxHeightError),
+	                nullptr, FColor::Cyan, 0.0f, false, 1.0f);
+}
+#endif
@@ -37,6 +37,8 @@ void UAlsLinkedAnimationInstance::NativeInitializeAnimation()
 		}
 	}
 #endif
+
+	ParentUnsafe = Parent.Get();
 }
 
 void UAlsLinkedAnimationInstance::NativeBeginPlay()
@@ -49,6 +51,13 @@ void UAlsLinkedAnimationInstance::NativeBeginPlay()
 	Super::NativeBeginPlay();
 }
 
+void UAlsLinkedAnimationInstance::NativeUpdateAnimation(const float DeltaTime)
+{
+	Super::NativeUpdateAnimation(DeltaTime);
+
+	ParentUnsafe = Parent.Get();
+}
+
 FAnimInstanceProxy* UAlsLinkedAnimationInstance::CreateAnimInstanceProxy()
 {
 	return new FAlsAnimationInstanceProxy{this};
@@ -56,136 +65,136 @@ FAnimInstanceProxy* UAlsLinkedAnimationInstance::CreateAnimInstanceProxy()
 
 void UAlsLinkedAnimationInstance::InitializeLook()
 {
-	if (Parent.IsValid())
+	if (ParentUnsafe != nullptr)
 	{
-		Parent->InitializeLook();
+		ParentUnsafe->InitializeLook();
 	}
 }
 
 void UAlsLinkedAnimationInstance::RefreshLook()
 {
-	if (Parent.IsValid())
+	if (ParentUnsafe != nullptr)
 	{
-		Parent->RefreshLook();
+		ParentUnsafe->RefreshLook();
 	}
 }
 
 void UAlsLinkedAnimationInstance::InitializeLean()
 {
-	if (Parent.IsValid())
+	if (ParentUnsafe != nullptr)
 	{
-		Parent->InitializeLean();
+		ParentUnsafe->InitializeLean();
 	}
 }
 
 void UAlsLinkedAnimationInstance::InitializeGrounded()
 {
-	if (Parent.IsValid())
+	if (ParentUnsafe != nullptr)
 	{
-		Parent->InitializeGrounded();
+		ParentUnsafe->InitializeGrounded();
 	}
 }
 
 void UAlsLinkedAnimationInstance::RefreshGrounded()
 {
-	if (Parent.IsValid())
+	if (ParentUnsafe != nullptr)
 	{
-		Parent->RefreshGrounded();
+		ParentUnsafe->RefreshGrounded();
 	}
 }
 
 void UAlsLinkedAnimationInstance::ResetGroundedEntryMode()
 {
-	if (Parent.IsValid())
+	if (ParentUnsafe != nullptr)
 	{
-		Parent->ResetGroundedEntryMode();
+		ParentUnsafe->ResetGroundedEntryMode();
 	}
 }
 
 void UAlsLinkedAnimationInstance::RefreshGroundedMovement()
 {
-	if (Parent.IsValid())
+	if (ParentUnsafe != nullptr)
 	{
-		Parent->RefreshGroundedMovement();
+		ParentUnsafe->RefreshGroundedMovement();
 	}
 }
 
 void UAlsLinkedAnimationInstance::SetHipsDirection(const EAlsHipsDirection NewHipsDirection)
 {
-	if (Parent.IsValid())
+	if (ParentUnsafe != nullptr)
 	{
-		Parent->SetHipsDirection(NewHipsDirection);
+		ParentUnsafe->SetHipsDirection(NewHipsDirection);
 	}
 }
 
 void UAlsLinkedAnimationInstance::InitializeStandingMovement()
 {
-	if (Parent.IsValid())
+	if (ParentUnsafe != nullptr)
 	{
-		Parent->InitializeStandingMovement();
+		ParentUnsafe->InitializeStandingMovement();
 	}
 }
 
 void UAlsLinkedAnimationInstance::RefreshStandingMovement()
 {
-	if (Parent.IsValid())
+	if (ParentUnsafe != nullptr)
 	{
-		Parent->RefreshStandingMovement();
+		ParentUnsafe->RefreshStandingMovement();
 	}
 }
 
 void UAlsLinkedAnimationInstance::ResetPivot()
 {
-	if (Parent.IsValid())
+	if (ParentUnsafe != nullptr)
 	{
-		Parent->ResetPivot();
+		ParentUnsafe->ResetPivot();
 	}
 }
 
 void UAlsLinkedAnimationInstance::RefreshCrouchingMovement()
 {
-	if (Parent.IsValid())
+	if (ParentUnsafe != nullptr)
 	{
-		Parent->RefreshCrouchingMovement();
+		ParentUnsafe->RefreshCrouchingMovement();
 	}
 }
 
 void UAlsLinkedAnimationInstance::RefreshInAir()
 {
-	if (Parent.IsValid())
+	if (ParentUnsafe != nullptr)
 	{
-		Parent->RefreshInAir();
+		ParentUnsafe->RefreshInAir();
 	}
 }
 
 void UAlsLinkedAnimationInstance::RefreshDynamicTransitions()
 {
-	if (Parent.IsValid())
+	if (ParentUnsafe != nullptr)
 	{
-		Parent->RefreshDynamicTransitions();
+		ParentUnsafe->RefreshDynamicTransitions();
 	}
 }
 
 void UAlsLinkedAnimationInstance::RefreshRotateInPlace()
 {
-	if (Parent.IsValid())
+	if (ParentUnsafe != nullptr)
 	{
-		Parent->RefreshRotateInPlace();
+		ParentUnsafe->RefreshRotateInPlace();
 	}
 }
 
 void UAlsLinkedAnimationInstance::InitializeTurnInPlace()
 {
-	if (Parent.IsValid())
+	if (ParentUnsafe != nullptr)
 	{
-		Parent->InitializeTurnInPlace();
+		ParentUnsafe->InitializeTurnInPlace();
 	}
 }
 
 void UAlsLinkedAnimationInstance::RefreshTurnInPlace()
 {
-	if (Parent.IsValid())
+	if (ParentUnsafe != nullptr)
 	{
-		Parent->RefreshTurnInPlace();
+		ParentUnsafe->RefreshTurnInPlace();
 	}
 }
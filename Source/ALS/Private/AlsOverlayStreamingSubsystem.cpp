@@ -0,0 +1,134 @@
+#include "AlsOverlayStreamingSubsystem.h"
+
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimSequenceBase.h"
+#include "Engine/AssetManager.h"
+#include "Utility/AlsUtility.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsOverlayStreamingSubsystem)
+
+DECLARE_MEMORY_STAT(TEXT("Resident Overlay Layer Animations"), STAT_AlsResidentOverlayLayerAnimations, STATGROUP_Als)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Overlay Layer Class Streaming Requests"), STAT_AlsOverlayLayerClassStreamingRequests, STATGROUP_Als)
+
+void UAlsOverlayStreamingSubsystem::Deinitialize()
+{
+	for (auto& [LayerClassPath, StreamedLayerClass] : LayerClasses)
+	{
+		if (StreamedLayerClass.StreamingHandle.IsValid())
+		{
+			StreamedLayerClass.StreamingHandle->CancelHandle();
+		}
+	}
+
+	LayerClasses.Reset();
+
+	DEC_MEMORY_STAT_BY(STAT_AlsResidentOverlayLayerAnimations, ResidentAnimationsMemory)
+	ResidentAnimationsMemory = 0;
+
+	Super::Deinitialize();
+}
+
+bool UAlsOverlayStreamingSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UAlsOverlayStreamingSubsystem::AddLayerClassReference(const TSoftClassPtr<UAnimInstance>& LayerClass)
+{
+	if (LayerClass.IsNull())
+	{
+		return;
+	}
+
+	const auto& LayerClassPath{LayerClass.ToSoftObjectPath()};
+	auto& StreamedLayerClass{LayerClasses.FindOrAdd(LayerClassPath)};
+
+	StreamedLayerClass.ReferencesCount += 1;
+
+	if (StreamedLayerClass.StreamingHandle.IsValid() || !UAssetManager::IsInitialized())
+	{
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_AlsOverlayLayerClassStreamingRequests)
+
+	StreamedLayerClass.StreamingHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		LayerClassPath, FStreamableDelegate::CreateUObject(this, &ThisClass::OnLayerClassLoaded, LayerClassPath),
+		FStreamableManager::AsyncLoadHighPriority);
+}
+
+void UAlsOverlayStreamingSubsystem::RemoveLayerClassReference(const TSoftClassPtr<UAnimInstance>& LayerClass)
+{
+	if (LayerClass.IsNull())
+	{
+		return;
+	}
+
+	const auto& LayerClassPath{LayerClass.ToSoftObjectPath()};
+	auto* StreamedLayerClass{LayerClasses.Find(LayerClassPath)};
+
+	if (StreamedLayerClass == nullptr)
+	{
+		return;
+	}
+
+	StreamedLayerClass->ReferencesCount -= 1;
+
+	if (StreamedLayerClass->ReferencesCount > 0)
+	{
+		return;
+	}
+
+	// Releasing the streaming handle allows the layer class and its animations to be garbage collected.
+
+	if (StreamedLayerClass->StreamingHandle.IsValid())
+	{
+		StreamedLayerClass->StreamingHandle->CancelHandle();
+	}
+
+	DEC_MEMORY_STAT_BY(STAT_AlsResidentOverlayLayerAnimations, StreamedLayerClass->AnimationsMemory)
+	ResidentAnimationsMemory -= StreamedLayerClass->AnimationsMemory;
+
+	LayerClasses.Remove(LayerClassPath);
+}
+
+int64 UAlsOverlayStreamingSubsystem::GetLayerClassAnimationsMemory(const TSoftClassPtr<UAnimInstance>& LayerClass) const
+{
+	const auto* StreamedLayerClass{LayerClasses.Find(LayerClass.ToSoftObjectPath())};
+
+	return StreamedLayerClass != nullptr ? StreamedLayerClass->AnimationsMemory : 0;
+}
+
+void UAlsOverlayStreamingSubsystem::OnLayerClassLoaded(const FSoftObjectPath LayerClassPath)
+{
+	auto* StreamedLayerClass{LayerClasses.Find(LayerClassPath)};
+	const auto* LayerClass{Cast<UClass>(LayerClassPath.ResolveObject())};
+
+	if (StreamedLayerClass == nullptr || !IsValid(LayerClass))
+	{
+		return;
+	}
+
+	// Estimate the memory used by the animations that the layer class references directly.
+
+	TArray<UObject*> ReferencedObjects;
+
+	FReferenceFinder ReferenceFinder{ReferencedObjects, nullptr, false, true, true, false};
+	ReferenceFinder.FindReferences(const_cast<UClass*>(LayerClass));
+	ReferenceFinder.FindReferences(LayerClass->GetDefaultObject());
+
+	int64 AnimationsMemory{0};
+
+	for (auto* ReferencedObject : ReferencedObjects)
+	{
+		if (IsValid(ReferencedObject) && ReferencedObject->IsA<UAnimSequenceBase>())
+		{
+			AnimationsMemory += ReferencedObject->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+		}
+	}
+
+	INC_MEMORY_STAT_BY(STAT_AlsResidentOverlayLayerAnimations, AnimationsMemory - StreamedLayerClass->AnimationsMemory)
+	ResidentAnimationsMemory += AnimationsMemory - StreamedLayerClass->AnimationsMemory;
+
+	StreamedLayerClass->AnimationsMemory = AnimationsMemory;
+}
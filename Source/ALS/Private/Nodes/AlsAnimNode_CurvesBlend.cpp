@@ -2,9 +2,12 @@
 
 #include "Animation/AnimTrace.h"
 #include "Utility/AlsEnumUtility.h"
+#include "Utility/AlsUtility.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AlsAnimNode_CurvesBlend)
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Curves Blend Scratch Pose Evaluations"), STAT_AlsCurvesBlendScratchPoseEvaluations, STATGROUP_Als)
+
 void FAlsAnimNode_CurvesBlend::Initialize_AnyThread(const FAnimationInitializeContext& Context)
 {
 	DECLARE_SCOPE_HIERARCHICAL_COUNTER_FUNC()
@@ -60,9 +63,15 @@ void FAlsAnimNode_CurvesBlend::Evaluate_AnyThread(FPoseContext& Output)
 		return;
 	}
 
-	auto CurvesPoseContext{Output};
+	// This constructor doesn't copy the bone transforms, curves and attributes of the output pose, it only allocates a new
+	// uninitialized pose on the animation memory stack. There is no curves only evaluation path for pose links, so the
+	// curves pose still has to be fully evaluated, but at least none of the output pose data is duplicated.
+
+	FPoseContext CurvesPoseContext{Output};
 	CurvesPose.Evaluate(CurvesPoseContext);
 
+	INC_DWORD_STAT(STAT_AlsCurvesBlendScratchPoseEvaluations)
+
 	switch (GetBlendMode())
 	{
 		case EAlsCurvesBlendMode::BlendByAmount:
@@ -86,7 +95,8 @@ void FAlsAnimNode_CurvesBlend::Evaluate_AnyThread(FPoseContext& Output)
 			break;
 
 		case EAlsCurvesBlendMode::Override:
-			Output.Curve.Override(CurvesPoseContext.Curve);
+			// The curves pose is discarded after this, so its curves can be moved instead of copied.
+			Output.Curve.MoveFrom(CurvesPoseContext.Curve);
 			break;
 	}
 }
@@ -2,13 +2,55 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AlsAnimNode_GameplayTagsBlend)
 
+void FAlsAnimNode_GameplayTagsBlend::Initialize_AnyThread(const FAnimationInitializeContext& Context)
+{
+	DECLARE_SCOPE_HIERARCHICAL_COUNTER_FUNC()
+
+	bTagIndicesValid = false;
+
+	Super::Initialize_AnyThread(Context);
+}
+
 int32 FAlsAnimNode_GameplayTagsBlend::GetActiveChildIndex()
 {
 	const auto& CurrentActiveTag{GetActiveTag()};
 
-	return CurrentActiveTag.IsValid()
-		       ? GetTags().Find(CurrentActiveTag) + 1
-		       : 0;
+	if (bTagIndicesValid && CurrentActiveTag == LastActiveTag)
+	{
+		return LastActiveChildIndex;
+	}
+
+	if (!bTagIndicesValid)
+	{
+		RefreshTagIndices();
+	}
+
+	const auto* TagIndex{CurrentActiveTag.IsValid() ? TagIndices.Find(CurrentActiveTag) : nullptr};
+
+	LastActiveTag = CurrentActiveTag;
+	LastActiveChildIndex = TagIndex != nullptr ? *TagIndex + 1 : 0;
+
+	return LastActiveChildIndex;
+}
+
+void FAlsAnimNode_GameplayTagsBlend::RefreshTagIndices()
+{
+	const auto& CurrentTags{GetTags()};
+
+	TagIndices.Reset();
+	TagIndices.Reserve(CurrentTags.Num());
+
+	for (auto i{0}; i < CurrentTags.Num(); i++)
+	{
+		// Keep the first occurrence of a tag to match the behavior of TArray::Find().
+
+		if (!TagIndices.Contains(CurrentTags[i]))
+		{
+			TagIndices.Emplace(CurrentTags[i], i);
+		}
+	}
+
+	bTagIndicesValid = true;
 }
 
 const FGameplayTag& FAlsAnimNode_GameplayTagsBlend::GetActiveTag() const
@@ -24,6 +66,8 @@ const TArray<FGameplayTag>& FAlsAnimNode_GameplayTagsBlend::GetTags() const
 #if WITH_EDITOR
 void FAlsAnimNode_GameplayTagsBlend::RefreshPosePins()
 {
+	bTagIndicesValid = false;
+
 	const auto Difference{BlendPose.Num() - GetTags().Num() - 1};
 	if (Difference == 0)
 	{
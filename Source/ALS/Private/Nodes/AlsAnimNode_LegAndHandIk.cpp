@@ -0,0 +1,379 @@
+#include "Nodes/AlsAnimNode_LegAndHandIk.h"
+
+#include "Animation/AnimInstanceProxy.h"
+#include "Animation/AnimTrace.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/HitResult.h"
+#include "Nodes/AlsRigUnit_ApplyFootOffsetLocation.h"
+#include "Nodes/AlsRigUnit_ApplyFootOffsetRotation.h"
+#include "Nodes/AlsRigUnit_FootOffsetTrace.h"
+#include "Nodes/AlsRigUnit_HandIkRetargeting.h"
+#include "TwoBoneIK.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsAnimNode_LegAndHandIk)
+
+void FAlsAnimNode_LegAndHandIk::Initialize_AnyThread(const FAnimationInitializeContext& Context)
+{
+	DECLARE_SCOPE_HIERARCHICAL_COUNTER_FUNC()
+
+	Super::Initialize_AnyThread(Context);
+
+	LeftLegState.bInitialized = false;
+	RightLegState.bInitialized = false;
+	bPelvisInitialized = false;
+
+	BlendInAmount = 0.0f;
+	UpdateCounter.Reset();
+}
+
+void FAlsAnimNode_LegAndHandIk::UpdateInternal(const FAnimationUpdateContext& Context)
+{
+	DECLARE_SCOPE_HIERARCHICAL_COUNTER_FUNC()
+
+	Super::UpdateInternal(Context);
+
+	DeltaTime = Context.GetDeltaTime();
+
+	// The node is not updated while it's skipped, for example, while the control rig is handling the character at
+	// lower LOD levels. Its state is outdated by then, so it's reinitialized and its output is blended in from the
+	// input pose, instead of being applied at full weight from the first frame, which would make the character snap.
+	// The update counter of the animation instance proxy is used instead of the frame counter, so that animation
+	// update rate optimizations, which skip entire animation instance updates, are not mistaken for reactivation.
+
+	if (!UpdateCounter.WasSynchronizedCounter(Context.AnimInstanceProxy->GetUpdateCounter()))
+	{
+		LeftLegState.bInitialized = false;
+		RightLegState.bInitialized = false;
+		bPelvisInitialized = false;
+
+		BlendInAmount = 0.0f;
+	}
+
+	UpdateCounter.SynchronizeWith(Context.AnimInstanceProxy->GetUpdateCounter());
+
+	BlendInAmount = BlendInDuration > UE_SMALL_NUMBER ? FMath::Min(1.0f, BlendInAmount + DeltaTime / BlendInDuration) : 1.0f;
+
+	ActualAlpha *= BlendInAmount;
+
+	TRACE_ANIM_NODE_VALUE(Context, TEXT("Pelvis Offset"), PelvisOffset);
+	TRACE_ANIM_NODE_VALUE(Context, TEXT("Left Foot Offset"), LeftLegState.OffsetLocationZ);
+	TRACE_ANIM_NODE_VALUE(Context, TEXT("Right Foot Offset"), RightLegState.OffsetLocationZ);
+}
+
+void FAlsAnimNode_LegAndHandIk::EvaluateSkeletalControl_AnyThread(FComponentSpacePoseContext& Output,
+                                                                  TArray<FBoneTransform>& OutBoneTransforms)
+{
+	DECLARE_SCOPE_HIERARCHICAL_COUNTER_FUNC()
+	ANIM_MT_SCOPE_CYCLE_COUNTER_VERBOSE(LegAndHandIk, !IsInGameThread());
+
+	// Every step depends on the result of the previous one, so the bone transforms are applied
+	// to the pose immediately, instead of being returned through the OutBoneTransforms array.
+
+	if (Input.bUseHandIkBones)
+	{
+		RefreshHandIkRetargeting(Output);
+	}
+
+	const auto& LeftFootTargetLocation{Input.FootLeftLocation};
+	const auto& RightFootTargetLocation{Input.FootRightLocation};
+
+	FVector LeftFootOffsetNormal;
+	const auto LeftFootOffsetLocationZ{
+		CalculateFootOffsetLocationZ(Output, LeftFootTargetLocation, EAlsFootBone::Left, LeftFootOffsetNormal)
+	};
+
+	FVector RightFootOffsetNormal;
+	const auto RightFootOffsetLocationZ{
+		CalculateFootOffsetLocationZ(Output, RightFootTargetLocation, EAlsFootBone::Right, RightFootOffsetNormal)
+	};
+
+	const auto LeftIkAmount{FMath::Clamp(Output.Curve.Get(UAlsConstants::FootLeftIkCurveName()), 0.0f, 1.0f)};
+	const auto RightIkAmount{FMath::Clamp(Output.Curve.Get(UAlsConstants::FootRightIkCurveName()), 0.0f, 1.0f)};
+
+	// Lower the pelvis by the lowest foot offset, so that both feet can reach the ground.
+
+	const auto TargetPelvisOffset{
+		FMath::Min(0.0f, FMath::Min(LeftFootOffsetLocationZ * LeftIkAmount, RightFootOffsetLocationZ * RightIkAmount))
+	};
+
+	if (!bPelvisInitialized)
+	{
+		bPelvisInitialized = true;
+
+		PelvisOffsetSpringState.Reset();
+		PelvisOffset = TargetPelvisOffset;
+	}
+	else
+	{
+		PelvisOffset = UAlsMath::SpringDampFloat(PelvisOffsetSpringState, PelvisOffset, TargetPelvisOffset, DeltaTime,
+		                                         OffsetInterpolationFrequency, OffsetInterpolationDampingRatio,
+		                                         OffsetInterpolationTargetVelocityAmount);
+	}
+
+	if (!FMath::IsNearlyZero(PelvisOffset))
+	{
+		const auto PelvisIndex{PelvisBone.GetCompactPoseIndex(Output.Pose.GetPose().GetBoneContainer())};
+
+		auto PelvisTransform{Output.Pose.GetComponentSpaceTransform(PelvisIndex)};
+		PelvisTransform.AddToTranslation({0.0f, 0.0f, PelvisOffset});
+
+		TArray<FBoneTransform, TInlineAllocator<1>> BoneTransforms{{PelvisIndex, PelvisTransform}};
+		Output.Pose.LocalBlendCSBoneTransforms(BoneTransforms, ActualAlpha);
+	}
+
+	RefreshLeg(Output, LeftLegState, LeftThighBone, LeftCalfBone, LeftFootBone, LeftFootTargetLocation,
+	           Input.FootLeftRotation, LeftFootOffsetLocationZ, LeftFootOffsetNormal, LeftIkAmount);
+
+	RefreshLeg(Output, RightLegState, RightThighBone, RightCalfBone, RightFootBone, RightFootTargetLocation,
+	           Input.FootRightRotation, RightFootOffsetLocationZ, RightFootOffsetNormal, RightIkAmount);
+}
+
+bool FAlsAnimNode_LegAndHandIk::IsValidToEvaluate(const USkeleton* Skeleton, const FBoneContainer& RequiredBones)
+{
+	return RequiredBones.GetCalculatedForLOD() >= MinLodLevel &&
+	       PelvisBone.IsValidToEvaluate(RequiredBones) &&
+	       LeftThighBone.IsValidToEvaluate(RequiredBones) &&
+	       LeftCalfBone.IsValidToEvaluate(RequiredBones) &&
+	       LeftFootBone.IsValidToEvaluate(RequiredBones) &&
+	       RightThighBone.IsValidToEvaluate(RequiredBones) &&
+	       RightCalfBone.IsValidToEvaluate(RequiredBones) &&
+	       RightFootBone.IsValidToEvaluate(RequiredBones);
+}
+
+void FAlsAnimNode_LegAndHandIk::GatherDebugData(FNodeDebugData& DebugData)
+{
+	DECLARE_SCOPE_HIERARCHICAL_COUNTER_ANIMNODE(GatherDebugData)
+
+	TStringBuilder<256> DebugItemBuilder{InPlace, DebugData.GetNodeName(this), TEXTVIEW(": Pelvis Offset: ")};
+
+	DebugItemBuilder.Appendf(TEXT("%.2f, Left Foot Offset: %.2f, Right Foot Offset: %.2f"),
+	                         PelvisOffset, LeftLegState.OffsetLocationZ, RightLegState.OffsetLocationZ);
+
+	DebugData.AddDebugItem(FString{DebugItemBuilder});
+	ComponentPose.GatherDebugData(DebugData);
+}
+
+void FAlsAnimNode_LegAndHandIk::InitializeBoneReferences(const FBoneContainer& RequiredBones)
+{
+	DECLARE_SCOPE_HIERARCHICAL_COUNTER_FUNC()
+
+	PelvisBone.Initialize(RequiredBones);
+
+	LeftThighBone.Initialize(RequiredBones);
+	LeftCalfBone.Initialize(RequiredBones);
+	LeftFootBone.Initialize(RequiredBones);
+
+	RightThighBone.Initialize(RequiredBones);
+	RightCalfBone.Initialize(RequiredBones);
+	RightFootBone.Initialize(RequiredBones);
+
+	LeftHandBone.Initialize(RequiredBones);
+	LeftHandIkBone.Initialize(RequiredBones);
+	RightHandBone.Initialize(RequiredBones);
+	RightHandIkBone.Initialize(RequiredBones);
+
+	for (auto& Bone : HandIkBonesToMove)
+	{
+		Bone.Initialize(RequiredBones);
+	}
+
+	// Same as the chain length rig unit with initial transforms, i.e. the sum of the reference pose bone lengths.
+
+	static const auto CalculateLegLength{
+		[](const FBoneContainer& Bones, const FBoneReference& CalfBone, const FBoneReference& FootBone)
+		{
+			if (!CalfBone.IsValidToEvaluate(Bones) || !FootBone.IsValidToEvaluate(Bones))
+			{
+				return 0.0f;
+			}
+
+			return UE_REAL_TO_FLOAT(Bones.GetRefPoseTransform(CalfBone.GetCompactPoseIndex(Bones)).GetLocation().Size() +
+			                        Bones.GetRefPoseTransform(FootBone.GetCompactPoseIndex(Bones)).GetLocation().Size());
+		}
+	};
+
+	LeftLegState.LegLength = CalculateLegLength(RequiredBones, LeftCalfBone, LeftFootBone);
+	RightLegState.LegLength = CalculateLegLength(RequiredBones, RightCalfBone, RightFootBone);
+
+	// Cache the children of the hand IK bones to move, so that they can be kept in place when the parent bones are moved.
+
+	HandIkBonesToMoveChildren.Reset();
+
+	if (!bPropagateToChildren)
+	{
+		TArray<FCompactPoseBoneIndex, TInlineAllocator<4>> MovedBoneIndices;
+
+		for (const auto& Bone : HandIkBonesToMove)
+		{
+			if (Bone.IsValidToEvaluate(RequiredBones))
+			{
+				MovedBoneIndices.Add(Bone.GetCompactPoseIndex(RequiredBones));
+			}
+		}
+
+		for (FCompactPoseBoneIndex BoneIndex{1}; BoneIndex < RequiredBones.GetCompactPoseNumBones(); ++BoneIndex)
+		{
+			if (!MovedBoneIndices.Contains(BoneIndex) && MovedBoneIndices.Contains(RequiredBones.GetParentBoneIndex(BoneIndex)))
+			{
+				HandIkBonesToMoveChildren.Add(BoneIndex);
+			}
+		}
+	}
+}
+
+void FAlsAnimNode_LegAndHandIk::RefreshHandIkRetargeting(FComponentSpacePoseContext& Output) const
+{
+	const auto& RequiredBones{Output.Pose.GetPose().GetBoneContainer()};
+
+	if (!FAnimWeight::IsRelevant(RetargetingAmount) ||
+	    !LeftHandBone.IsValidToEvaluate(RequiredBones) || !LeftHandIkBone.IsValidToEvaluate(RequiredBones) ||
+	    !RightHandBone.IsValidToEvaluate(RequiredBones) || !RightHandIkBone.IsValidToEvaluate(RequiredBones))
+	{
+		return;
+	}
+
+	const auto RetargetingOffset{
+		FAlsRigUnit_HandIkRetargeting::CalculateRetargetingOffset(
+			Output.Pose.GetComponentSpaceTransform(LeftHandBone.GetCompactPoseIndex(RequiredBones)).GetLocation(),
+			Output.Pose.GetComponentSpaceTransform(LeftHandIkBone.GetCompactPoseIndex(RequiredBones)).GetLocation(),
+			Output.Pose.GetComponentSpaceTransform(RightHandBone.GetCompactPoseIndex(RequiredBones)).GetLocation(),
+			Output.Pose.GetComponentSpaceTransform(RightHandIkBone.GetCompactPoseIndex(RequiredBones)).GetLocation(),
+			RetargetingWeight, RetargetingAmount)
+	};
+
+	if (RetargetingOffset.IsNearlyZero())
+	{
+		return;
+	}
+
+	TArray<FBoneTransform, TInlineAllocator<8>> BoneTransforms;
+	BoneTransforms.Reserve(HandIkBonesToMove.Num() + HandIkBonesToMoveChildren.Num());
+
+	for (const auto& Bone : HandIkBonesToMove)
+	{
+		if (Bone.IsValidToEvaluate(RequiredBones))
+		{
+			const auto BoneIndex{Bone.GetCompactPoseIndex(RequiredBones)};
+
+			auto BoneTransform{Output.Pose.GetComponentSpaceTransform(BoneIndex)};
+			BoneTransform.AddToTranslation(RetargetingOffset);
+
+			BoneTransforms.Emplace(BoneIndex, BoneTransform);
+		}
+	}
+
+	for (const auto BoneIndex : HandIkBonesToMoveChildren)
+	{
+		BoneTransforms.Emplace(BoneIndex, Output.Pose.GetComponentSpaceTransform(BoneIndex));
+	}
+
+	BoneTransforms.Sort(FCompareBoneTransformIndex{});
+
+	Output.Pose.LocalBlendCSBoneTransforms(BoneTransforms, ActualAlpha);
+}
+
+float FAlsAnimNode_LegAndHandIk::CalculateFootOffsetLocationZ(const FComponentSpacePoseContext& Output,
+                                                              const FVector& FootTargetLocation, const EAlsFootBone FootBone,
+                                                              FVector& FootOffsetNormal) const
+{
+	const auto* Mesh{Output.AnimInstanceProxy->GetSkelMeshComponent()};
+
+	if (!Input.bFootOffsetAllowed || !IsValid(Mesh) || !IsValid(Mesh->GetWorld()))
+	{
+		FootOffsetNormal = FVector::ZAxisVector;
+		return 0.0f;
+	}
+
+	const auto& ComponentTransform{Output.AnimInstanceProxy->GetComponentTransform()};
+
+	FHitResult Hit;
+	FAlsRigUnit_FootOffsetTrace::TraceGround(Mesh->GetWorld(), Mesh, ComponentTransform, FootTargetLocation, TraceChannel,
+	                                         TraceDistanceUpward, TraceDistanceDownward, FootBone, bUseGroundHeightCache,
+	                                         bAsyncTrace, MaxAsyncTraceExtrapolationDistance, false, Hit);
+
+	float FootOffsetLocationZ;
+	FAlsRigUnit_FootOffsetTrace::CalculateFootOffset(Hit, ComponentTransform, WalkableFloorAngle, FootHeight,
+	                                                 FootOffsetLocationZ, FootOffsetNormal);
+
+	return FootOffsetLocationZ;
+}
+
+void FAlsAnimNode_LegAndHandIk::RefreshLeg(FComponentSpacePoseContext& Output, FAlsLegIkState& LegState,
+                                           const FBoneReference& ThighBone, const FBoneReference& CalfBone,
+                                           const FBoneReference& FootBone, const FVector& FootTargetLocation,
+                                           const FQuat& FootTargetRotation, const float FootOffsetLocationZ,
+                                           const FVector& FootOffsetNormal, const float IkAmount)
+{
+	const auto& RequiredBones{Output.Pose.GetPose().GetBoneContainer()};
+
+	const auto PelvisIndex{PelvisBone.GetCompactPoseIndex(RequiredBones)};
+	const auto ThighIndex{ThighBone.GetCompactPoseIndex(RequiredBones)};
+	const auto CalfIndex{CalfBone.GetCompactPoseIndex(RequiredBones)};
+	const auto FootIndex{FootBone.GetCompactPoseIndex(RequiredBones)};
+
+	auto ThighTransform{Output.Pose.GetComponentSpaceTransform(ThighIndex)};
+	auto CalfTransform{Output.Pose.GetComponentSpaceTransform(CalfIndex)};
+	auto FootTransform{Output.Pose.GetComponentSpaceTransform(FootIndex)};
+
+	// Foot offset location.
+
+	const auto TargetOffsetLocationZ{
+		FAlsRigUnit_ApplyFootOffsetLocation::CalculateTargetOffsetLocationZ(
+			UE_REAL_TO_FLOAT(FootTargetLocation.Z), FootOffsetLocationZ,
+			UE_REAL_TO_FLOAT(Output.Pose.GetComponentSpaceTransform(PelvisIndex).GetLocation().Z),
+			PelvisOffset, MinPelvisToFootDistanceZ)
+	};
+
+	if (!LegState.bInitialized)
+	{
+		LegState.bInitialized = true;
+
+		LegState.OffsetSpringState.Reset();
+		LegState.OffsetLocationZ = TargetOffsetLocationZ;
+		LegState.OffsetNormal = FootOffsetNormal;
+	}
+	else
+	{
+		LegState.OffsetLocationZ = UAlsMath::SpringDampFloat(LegState.OffsetSpringState, LegState.OffsetLocationZ,
+		                                                     TargetOffsetLocationZ, DeltaTime, OffsetInterpolationFrequency,
+		                                                     OffsetInterpolationDampingRatio,
+		                                                     OffsetInterpolationTargetVelocityAmount);
+	}
+
+	const auto FootLocation{
+		FAlsRigUnit_ApplyFootOffsetLocation::LimitLegStretch(
+			{FootTargetLocation.X, FootTargetLocation.Y, FootTargetLocation.Z + LegState.OffsetLocationZ},
+			ThighTransform.GetLocation(), LegState.LegLength * MaxLegStretchRatio)
+	};
+
+	// Foot offset rotation.
+
+	LegState.OffsetNormal = UAlsMath::ExponentialDecay(LegState.OffsetNormal, FootOffsetNormal,
+	                                                   DeltaTime, RotationOffsetInterpolationSpeed);
+
+	const auto FootRotation{
+		FAlsRigUnit_ApplyFootOffsetRotation::CalculateFootRotation(CalfTransform.GetRotation(), FootTargetRotation,
+		                                                           LegState.OffsetNormal, LimitOffset, Swing1LimitAngle,
+		                                                           Swing2LimitAngle, TwistLimitAngle)
+	};
+
+	if (!FAnimWeight::IsRelevant(IkAmount))
+	{
+		return;
+	}
+
+	// Leg IK. The calf location is used as the joint target to preserve the knee direction from the animation.
+
+	AnimationCore::SolveTwoBoneIK(ThighTransform, CalfTransform, FootTransform, CalfTransform.GetLocation(),
+	                              FootLocation, false, 1.0f, 1.0f);
+
+	FootTransform.SetRotation(FootRotation);
+
+	TArray<FBoneTransform, TInlineAllocator<3>> BoneTransforms{
+		{ThighIndex, ThighTransform},
+		{CalfIndex, CalfTransform},
+		{FootIndex, FootTransform}
+	};
+
+	Output.Pose.LocalBlendCSBoneTransforms(BoneTransforms, IkAmount * ActualAlpha);
+}
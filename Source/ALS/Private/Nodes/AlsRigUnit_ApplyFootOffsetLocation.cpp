@@ -2,6 +2,29 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AlsRigUnit_ApplyFootOffsetLocation)
 
+float FAlsRigUnit_ApplyFootOffsetLocation::CalculateTargetOffsetLocationZ(const float FootTargetLocationZ, const float FootOffsetLocationZ,
+                                                                          const float PelvisLocationZ, const float PelvisOffset,
+                                                                          const float MinPelvisToFootDistanceZ)
+{
+	const auto MaxFootLocationZ{PelvisLocationZ - MinPelvisToFootDistanceZ};
+	const auto MaxFootOffsetLocationZ{MaxFootLocationZ - FootTargetLocationZ};
+
+	// Limit how high the foot offset can raise the foot relative to the pelvis.
+	const auto TargetOffsetLocationZ{FMath::Min(FootOffsetLocationZ, MaxFootOffsetLocationZ)};
+
+	// Do not allow the foot offset to be lower than the pelvis offset to prevent leg stretching.
+	return FMath::Max(TargetOffsetLocationZ, PelvisOffset);
+}
+
+FVector FAlsRigUnit_ApplyFootOffsetLocation::LimitLegStretch(const FVector& FootLocation, const FVector& ThighLocation,
+                                                             const float MaxLegLength)
+{
+	const auto LegVector{FootLocation - ThighLocation};
+	const auto ClampedLegVector{LegVector.GetClampedToMaxSize(MaxLegLength)};
+
+	return ThighLocation + ClampedLegVector;
+}
+
 void FAlsRigUnit_ApplyFootOffsetLocation::Initialize()
 {
 	bInitialized = false;
@@ -23,14 +46,10 @@ FAlsRigUnit_ApplyFootOffsetLocation_Execute()
 	const auto PelvisLocationZ{UE_REAL_TO_FLOAT(Hierarchy->GetGlobalTransform(CachedPelvisItem).GetLocation().Z)};
 	const auto ThighLocation{Hierarchy->GetGlobalTransform(CachedThighItem).GetLocation()};
 
-	const auto MaxFootLocationZ{PelvisLocationZ - MinPelvisToFootDistanceZ};
-	const auto MaxFootOffsetLocationZ{MaxFootLocationZ - UE_REAL_TO_FLOAT(FootTargetLocation.Z)};
-
-	// Limit how high the foot offset can raise the foot relative to the pelvis.
-	auto TargetOffsetLocationZ{FMath::Min(FootOffsetLocationZ, MaxFootOffsetLocationZ)};
-
-	// Do not allow the foot offset to be lower than the pelvis offset to prevent leg stretching.
-	TargetOffsetLocationZ = FMath::Max(TargetOffsetLocationZ, PelvisOffset);
+	const auto TargetOffsetLocationZ{
+		CalculateTargetOffsetLocationZ(UE_REAL_TO_FLOAT(FootTargetLocation.Z), FootOffsetLocationZ,
+		                               PelvisLocationZ, PelvisOffset, MinPelvisToFootDistanceZ)
+	};
 
 	if (!bInitialized)
 	{
@@ -52,8 +71,5 @@ FAlsRigUnit_ApplyFootOffsetLocation_Execute()
 
 	// Prevent the leg from being fully straightened. We do this after offset interpolation, otherwise the effect will not be noticeable.
 
-	const auto LegVector{FootLocation - ThighLocation};
-	const auto ClampedLegVector{LegVector.GetClampedToMaxSize(LegLength * MaxLegStretchRatio)};
-
-	FootLocation = ThighLocation + ClampedLegVector;
+	FootLocation = LimitLegStretch(FootLocation, ThighLocation, LegLength * MaxLegStretchRatio);
 }
@@ -5,39 +5,15 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AlsRigUnit_ApplyFootOffsetRotation)
 
-void FAlsRigUnit_ApplyFootOffsetRotation::Initialize()
-{
-	bInitialized = false;
-}
-
-FAlsRigUnit_ApplyFootOffsetRotation_Execute()
+FQuat FAlsRigUnit_ApplyFootOffsetRotation::CalculateFootRotation(const FQuat& CalfRotation, const FQuat& FootTargetRotation,
+                                                                const FVector& OffsetNormal, const FQuat& LimitOffset,
+                                                                const float Swing1LimitAngle, const float Swing2LimitAngle,
+                                                                const float TwistLimitAngle)
 {
-	DECLARE_SCOPE_HIERARCHICAL_COUNTER_RIGUNIT()
-
-	const auto* Hierarchy{ExecuteContext.Hierarchy};
-
-	if (!IsValid(Hierarchy) ||
-	    !CachedCalfItem.UpdateCache(CalfItem, Hierarchy))
-	{
-		return;
-	}
-
-	if (!bInitialized)
-	{
-		bInitialized = true;
-
-		OffsetNormal = FootOffsetNormal;
-	}
-
-	OffsetNormal = UAlsMath::ExponentialDecay(OffsetNormal, FootOffsetNormal,
-	                                          UE_REAL_TO_FLOAT(ExecuteContext.GetDeltaTime()), OffsetInterpolationSpeed);
-
 	const auto OffsetRotation{FQuat::FindBetweenVectors(FVector::ZAxisVector, OffsetNormal)};
 
 	// Convert global offset to local offset.
 
-	const auto CalfRotation{Hierarchy->GetGlobalTransform(CachedCalfItem).GetRotation()};
-
 	const auto InitialLocalRotation{CalfRotation.Inverse() * FootTargetRotation * LimitOffset};
 
 	const auto TargetRotation{OffsetRotation * FootTargetRotation};
@@ -104,6 +80,41 @@ FAlsRigUnit_ApplyFootOffsetRotation_Execute()
 
 	const auto NewLocalRotation{NewSwing * NewTwist};
 
-	FootRotation = CalfRotation * NewLocalRotation * LimitOffset.Inverse();
+	auto FootRotation{CalfRotation * NewLocalRotation * LimitOffset.Inverse()};
 	FootRotation.Normalize();
+
+	return FootRotation;
+}
+
+void FAlsRigUnit_ApplyFootOffsetRotation::Initialize()
+{
+	bInitialized = false;
+}
+
+FAlsRigUnit_ApplyFootOffsetRotation_Execute()
+{
+	DECLARE_SCOPE_HIERARCHICAL_COUNTER_RIGUNIT()
+
+	const auto* Hierarchy{ExecuteContext.Hierarchy};
+
+	if (!IsValid(Hierarchy) ||
+	    !CachedCalfItem.UpdateCache(CalfItem, Hierarchy))
+	{
+		return;
+	}
+
+	if (!bInitialized)
+	{
+		bInitialized = true;
+
+		OffsetNormal = FootOffsetNormal;
+	}
+
+	OffsetNormal = UAlsMath::ExponentialDecay(OffsetNormal, FootOffsetNormal,
+	                                          UE_REAL_TO_FLOAT(ExecuteContext.GetDeltaTime()), OffsetInterpolationSpeed);
+
+	const auto CalfRotation{Hierarchy->GetGlobalTransform(CachedCalfItem).GetRotation()};
+
+	FootRotation = CalculateFootRotation(CalfRotation, FootTargetRotation, OffsetNormal, LimitOffset,
+	                                     Swing1LimitAngle, Swing2LimitAngle, TwistLimitAngle);
 }
@@ -4,68 +4,80 @@
 
 namespace AlsChainLengthRigUnit
 {
-	float CalculateChainLength(FRigTransformElement* AncestorElement, FRigTransformElement* DescendantElement,
-	                           const URigHierarchy* Hierarchy, const ERigTransformType::Type TransformType, TBitArray<>& VisitedElements)
+	bool CollectChainIndices(const FRigTransformElement* AncestorElement, const FRigTransformElement* DescendantElement,
+	                         TBitArray<>& VisitedElements, TArray<int32>& ChainIndices)
 	{
 		// Based on URigHierarchy::IsDependentOn().
 
 		if (AncestorElement == nullptr || DescendantElement == nullptr)
 		{
-			return -1.0f;
+			return false;
 		}
 
 		if (DescendantElement == AncestorElement)
 		{
-			return 0.0f;
+			ChainIndices.Add(DescendantElement->GetIndex());
+			return true;
 		}
 
-		const auto DescendantElementIndex{DescendantElement->GetIndex()};
+		// Guards against cycles in malformed hierarchies, which would otherwise cause infinite recursion.
 
-		if (!VisitedElements.IsValidIndex(DescendantElementIndex))
-		{
-			return -1.0f;
-		}
+		const auto DescendantElementIndex{DescendantElement->GetIndex()};
 
-		if (VisitedElements[DescendantElementIndex])
+		if (!VisitedElements.IsValidIndex(DescendantElementIndex) || VisitedElements[DescendantElementIndex])
 		{
-			return -1.0f;
+			return false;
 		}
 
-		float ChainLength{-1.0};
-		FRigTransformElement* ParentElement{nullptr};
+		VisitedElements[DescendantElementIndex] = true;
 
 		const auto* SingleParentElement{Cast<FRigSingleParentElement>(DescendantElement)};
 		if (SingleParentElement != nullptr)
 		{
-			ParentElement = SingleParentElement->ParentElement;
-			ChainLength = CalculateChainLength(AncestorElement, ParentElement, Hierarchy, TransformType, VisitedElements);
+			if (!CollectChainIndices(AncestorElement, SingleParentElement->ParentElement, VisitedElements, ChainIndices))
+			{
+				return false;
+			}
+
+			ChainIndices.Add(DescendantElement->GetIndex());
+			return true;
 		}
-		else
+
+		const auto* MultiParentElement{Cast<FRigMultiParentElement>(DescendantElement)};
+		if (MultiParentElement != nullptr)
 		{
-			const auto* MultiParentElement{Cast<FRigMultiParentElement>(DescendantElement)};
-			if (MultiParentElement != nullptr)
+			for (const auto& ParentConstraint : MultiParentElement->ParentConstraints)
 			{
-				for (const auto& ParentConstraint : MultiParentElement->ParentConstraints)
+				if (CollectChainIndices(AncestorElement, ParentConstraint.ParentElement, VisitedElements, ChainIndices))
 				{
-					ParentElement = ParentConstraint.ParentElement;
-					ChainLength = CalculateChainLength(AncestorElement, ParentElement, Hierarchy, TransformType, VisitedElements);
-
-					if (ChainLength >= 0.0f)
-					{
-						break;
-					}
+					ChainIndices.Add(DescendantElement->GetIndex());
+					return true;
 				}
 			}
 		}
 
-		if (ChainLength < 0.0f)
+		return false;
+	}
+
+	float CalculateChainLength(const TArray<int32>& ChainIndices, const URigHierarchy* Hierarchy, const bool bInitial)
+	{
+		if (ChainIndices.Num() <= 1)
+		{
+			return 0.0f;
+		}
+
+		auto ChainLength{0.0f};
+		auto PreviousLocation{Hierarchy->GetGlobalTransform(ChainIndices[0], bInitial).GetLocation()};
+
+		for (auto i{1}; i < ChainIndices.Num(); i++)
 		{
-			return -1.0f;
+			const auto Location{Hierarchy->GetGlobalTransform(ChainIndices[i], bInitial).GetLocation()};
+
+			ChainLength += UE_REAL_TO_FLOAT(FVector::Distance(PreviousLocation, Location));
+			PreviousLocation = Location;
 		}
 
-		return UE_REAL_TO_FLOAT(ChainLength + FVector::Distance(
-			Hierarchy->GetTransform(DescendantElement, TransformType).GetLocation(),
-			Hierarchy->GetTransform(ParentElement, TransformType).GetLocation()));
+		return ChainLength;
 	}
 }
 
@@ -82,17 +94,36 @@ FAlsRigUnit_ChainLength_Execute()
 		return;
 	}
 
-	auto* AncestorTransformElement{const_cast<FRigTransformElement*>(Cast<FRigTransformElement>(CachedAncestorItem.GetElement()))};
-	auto* DescendantTransformElement{const_cast<FRigTransformElement*>(Cast<FRigTransformElement>(CachedDescendantItem.GetElement()))};
-	const auto TransformType{bInitial ? ERigTransformType::InitialGlobal : ERigTransformType::CurrentGlobal};
-	TBitArray VisitedElements{false, Hierarchy->Num()};
+	// The chain topology doesn't change unless the hierarchy does, so walk the
+	// hierarchy only if the chain items or the hierarchy topology change.
 
-	Length = AlsChainLengthRigUnit::CalculateChainLength(AncestorTransformElement, DescendantTransformElement,
-	                                                     Hierarchy, TransformType, VisitedElements);
-
-	if (Length < 0.0f)
+	if (CachedChainTopologyVersion != static_cast<int32>(Hierarchy->GetTopologyVersion()) ||
+	    CachedChainAncestorItem != AncestorItem || CachedChainDescendantItem != DescendantItem)
 	{
-		Length = FMath::Max(0.0f, AlsChainLengthRigUnit::CalculateChainLength(DescendantTransformElement, AncestorTransformElement,
-		                                                                      Hierarchy, TransformType, VisitedElements));
+		CachedChainTopologyVersion = static_cast<int32>(Hierarchy->GetTopologyVersion());
+		CachedChainAncestorItem = AncestorItem;
+		CachedChainDescendantItem = DescendantItem;
+
+		const auto* AncestorTransformElement{Cast<FRigTransformElement>(CachedAncestorItem.GetElement())};
+		const auto* DescendantTransformElement{Cast<FRigTransformElement>(CachedDescendantItem.GetElement())};
+
+		CachedChainIndices.Reset();
+
+		TBitArray VisitedElements{false, Hierarchy->Num()};
+
+		if (!AlsChainLengthRigUnit::CollectChainIndices(AncestorTransformElement, DescendantTransformElement,
+		                                                VisitedElements, CachedChainIndices))
+		{
+			CachedChainIndices.Reset();
+			VisitedElements.Init(false, Hierarchy->Num());
+
+			if (!AlsChainLengthRigUnit::CollectChainIndices(DescendantTransformElement, AncestorTransformElement,
+			                                                VisitedElements, CachedChainIndices))
+			{
+				CachedChainIndices.Reset();
+			}
+		}
 	}
+
+	Length = AlsChainLengthRigUnit::CalculateChainLength(CachedChainIndices, Hierarchy, bInitial);
 }
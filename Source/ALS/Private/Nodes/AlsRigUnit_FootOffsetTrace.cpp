@@ -1,42 +1,65 @@
 #include "Nodes/AlsRigUnit_FootOffsetTrace.h"
 
+#include "AlsAnimationInstance.h"
+#include "AlsFootTraceSubsystem.h"
+#include "AlsGroundHeightCacheComponent.h"
+#include "Components/SkeletalMeshComponent.h"
 #include "Engine/HitResult.h"
 #include "Engine/World.h"
+#include "Utility/AlsUtility.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AlsRigUnit_FootOffsetTrace)
 
-FAlsRigUnit_FootOffsetTrace_Execute()
+DECLARE_DWORD_COUNTER_STAT(TEXT("Foot Offset Ground Height Cache Hits"), STAT_AlsFootOffsetGroundHeightCacheHits, STATGROUP_Als)
+
+void FAlsRigUnit_FootOffsetTrace::TraceGround(const UWorld* World, const USceneComponent* OwningComponent,
+                                              const FTransform& ComponentTransform, const FVector& FootTargetLocation,
+                                              const ECollisionChannel TraceChannel, const float TraceDistanceUpward,
+                                              const float TraceDistanceDownward, const EAlsFootBone FootBone,
+                                              const bool bUseGroundHeightCache, const bool bAsyncTrace,
+                                              const float MaxAsyncTraceExtrapolationDistance, const bool bReturnPhysicalMaterial,
+                                              FHitResult& Hit)
 {
-	DECLARE_SCOPE_HIERARCHICAL_COUNTER_RIGUNIT()
+	// Trace downward from the foot location to find the geometry.
 
-	if (!bEnabled)
-	{
-		OffsetLocationZ = 0.0f;
-		OffsetNormal = FVector::ZAxisVector;
-		return;
-	}
+	const auto WorldTraceStart{ComponentTransform.TransformPosition({FootTargetLocation.X, FootTargetLocation.Y, TraceDistanceUpward})};
+	const auto WorldTraceEnd{ComponentTransform.TransformPosition({FootTargetLocation.X, FootTargetLocation.Y, -TraceDistanceDownward})};
 
-	// Trace downward from the foot location to find the geometry. If the surface is walkable, save the impact location and normal.
+	const auto* OwningActor{IsValid(OwningComponent) ? OwningComponent->GetOwner() : nullptr};
 
-	const FVector TraceStart{FootTargetLocation.X, FootTargetLocation.Y, TraceDistanceUpward};
-	const FVector TraceEnd{FootTargetLocation.X, FootTargetLocation.Y, -TraceDistanceDownward};
+	const auto* GroundHeightCache{
+		bUseGroundHeightCache && IsValid(OwningActor) ? OwningActor->FindComponentByClass<UAlsGroundHeightCacheComponent>() : nullptr
+	};
 
-	FHitResult Hit;
-	ExecuteContext.GetWorld()->LineTraceSingleByChannel(Hit, ExecuteContext.ToWorldSpace(TraceStart), ExecuteContext.ToWorldSpace(TraceEnd),
-	                                                    TraceChannel, {__FUNCTION__, true, ExecuteContext.GetOwningActor()});
+	auto* TraceSubsystem{bAsyncTrace && IsValid(OwningComponent) ? World->GetSubsystem<UAlsFootTraceSubsystem>() : nullptr};
 
-	auto* DrawInterface{ExecuteContext.GetDrawInterface()};
-	if (DrawInterface != nullptr && bDrawDebug)
+	Hit = FHitResult{WorldTraceStart, WorldTraceEnd};
+
+	if (IsValid(GroundHeightCache) && GroundHeightCache->TryGetGround(ComponentTransform.TransformPosition(FootTargetLocation), Hit) &&
+	    FMath::IsWithinInclusive(ComponentTransform.InverseTransformPosition(Hit.ImpactPoint).Z, -TraceDistanceDownward, TraceDistanceUpward))
+	{
+		INC_DWORD_STAT(STAT_AlsFootOffsetGroundHeightCacheHits)
+	}
+	else if (!IsValid(TraceSubsystem) ||
+	         !TraceSubsystem->TryGetFootTraceHit(OwningComponent, FootBone, WorldTraceStart, WorldTraceEnd, TraceChannel,
+	                                             OwningActor, MaxAsyncTraceExtrapolationDistance, Hit))
 	{
-		DrawInterface->DrawLine(FTransform::Identity, TraceStart, TraceEnd, {0.0f, 0.25f, 1.0f}, 1.0f);
+		FCollisionQueryParams QueryParameters{__FUNCTION__, true, OwningActor};
+		QueryParameters.bReturnPhysicalMaterial = bReturnPhysicalMaterial;
 
-		if (Hit.bBlockingHit)
-		{
-			DrawInterface->DrawPoint(FTransform::Identity, Hit.ImpactPoint, 12.0f, {0.0f, 0.75f, 1.0f});
-		}
+		Hit.Reset();
+
+		World->LineTraceSingleByChannel(Hit, WorldTraceStart, WorldTraceEnd, TraceChannel, QueryParameters);
 	}
+}
 
-	const auto HitNormal{ExecuteContext.GetToWorldSpaceTransform().InverseTransformVector(Hit.ImpactNormal)};
+void FAlsRigUnit_FootOffsetTrace::CalculateFootOffset(const FHitResult& Hit, const FTransform& ComponentTransform,
+                                                      const float WalkableFloorAngle, const float FootHeight,
+                                                      float& OffsetLocationZ, FVector& OffsetNormal)
+{
+	// If the surface is walkable, use the impact location and normal.
+
+	const auto HitNormal{ComponentTransform.InverseTransformVector(Hit.ImpactNormal)};
 
 	if (!Hit.bBlockingHit || HitNormal.Z < FMath::Cos(FMath::DegreesToRadians(WalkableFloorAngle)))
 	{
@@ -45,7 +68,7 @@ FAlsRigUnit_FootOffsetTrace_Execute()
 		return;
 	}
 
-	const auto HitLocation{ExecuteContext.ToVMSpace(Hit.ImpactPoint)};
+	const auto HitLocation{ComponentTransform.InverseTransformPosition(Hit.ImpactPoint)};
 
 	// Calculate how much we need to offset the foot along the Z axis to get it perfectly aligned with the sloped surface.
 	// Without this, the foot will sink into the surface. This formula can be derived from the right triangle cosine formula
@@ -58,3 +81,48 @@ FAlsRigUnit_FootOffsetTrace_Execute()
 	OffsetLocationZ = UE_REAL_TO_FLOAT(HitLocation.Z + SlopeOffsetZ);
 	OffsetNormal = HitNormal;
 }
+
+FAlsRigUnit_FootOffsetTrace_Execute()
+{
+	DECLARE_SCOPE_HIERARCHICAL_COUNTER_RIGUNIT()
+
+	if (!bEnabled)
+	{
+		OffsetLocationZ = 0.0f;
+		OffsetNormal = FVector::ZAxisVector;
+		return;
+	}
+
+	const auto* OwningComponent{ExecuteContext.GetOwningComponent()};
+	const auto& ComponentTransform{ExecuteContext.GetToWorldSpaceTransform()};
+
+	FHitResult Hit;
+	TraceGround(ExecuteContext.GetWorld(), OwningComponent, ComponentTransform, FootTargetLocation, TraceChannel,
+	            TraceDistanceUpward, TraceDistanceDownward, FootBone, bUseGroundHeightCache, bAsyncTrace,
+	            MaxAsyncTraceExtrapolationDistance, bPublishToFootGroundCache, Hit);
+
+	if (bPublishToFootGroundCache)
+	{
+		const auto* Mesh{Cast<USkeletalMeshComponent>(OwningComponent)};
+		auto* AnimationInstance{IsValid(Mesh) ? Cast<UAlsAnimationInstance>(Mesh->GetAnimInstance()) : nullptr};
+
+		if (IsValid(AnimationInstance))
+		{
+			AnimationInstance->SetFootGroundHit(FootBone, Hit);
+		}
+	}
+
+	auto* DrawInterface{ExecuteContext.GetDrawInterface()};
+	if (DrawInterface != nullptr && bDrawDebug)
+	{
+		DrawInterface->DrawLine(FTransform::Identity, {FootTargetLocation.X, FootTargetLocation.Y, TraceDistanceUpward},
+		                        {FootTargetLocation.X, FootTargetLocation.Y, -TraceDistanceDownward}, {0.0f, 0.25f, 1.0f}, 1.0f);
+
+		if (Hit.bBlockingHit)
+		{
+			DrawInterface->DrawPoint(FTransform::Identity, Hit.ImpactPoint, 12.0f, {0.0f, 0.75f, 1.0f});
+		}
+	}
+
+	CalculateFootOffset(Hit, ComponentTransform, WalkableFloorAngle, FootHeight, OffsetLocationZ, OffsetNormal);
+}
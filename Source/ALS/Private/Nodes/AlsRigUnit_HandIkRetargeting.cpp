@@ -2,6 +2,29 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AlsRigUnit_HandIkRetargeting)
 
+FVector FAlsRigUnit_HandIkRetargeting::CalculateRetargetingOffset(const FVector& LeftHandLocation, const FVector& LeftHandIkLocation,
+                                                                  const FVector& RightHandLocation, const FVector& RightHandIkLocation,
+                                                                  const float RetargetingWeight, const float Weight)
+{
+	FVector RetargetingOffset;
+
+	if (FAnimWeight::IsFullWeight(RetargetingWeight))
+	{
+		RetargetingOffset = RightHandLocation - RightHandIkLocation;
+	}
+	else if (!FAnimWeight::IsRelevant(RetargetingWeight))
+	{
+		RetargetingOffset = LeftHandLocation - LeftHandIkLocation;
+	}
+	else
+	{
+		RetargetingOffset = FMath::Lerp(LeftHandLocation, RightHandLocation, RetargetingWeight) -
+		                    FMath::Lerp(LeftHandIkLocation, RightHandIkLocation, RetargetingWeight);
+	}
+
+	return RetargetingOffset * FMath::Min(1.0f, Weight);
+}
+
 FAlsRigUnit_HandIkRetargeting_Execute()
 {
 	DECLARE_SCOPE_HIERARCHICAL_COUNTER_RIGUNIT()
@@ -22,29 +45,13 @@ FAlsRigUnit_HandIkRetargeting_Execute()
 		return;
 	}
 
-	FVector RetargetingOffset;
-
-	if (FAnimWeight::IsFullWeight(RetargetingWeight))
-	{
-		RetargetingOffset = Hierarchy->GetGlobalTransform(CachedRightHandItem).GetLocation() -
-		                    Hierarchy->GetGlobalTransform(CachedRightHandIkItem).GetLocation();
-	}
-	else if (!FAnimWeight::IsRelevant(RetargetingWeight))
-	{
-		RetargetingOffset = Hierarchy->GetGlobalTransform(CachedLeftHandItem).GetLocation() -
-		                    Hierarchy->GetGlobalTransform(CachedLeftHandIkItem).GetLocation();
-	}
-	else
-	{
-		RetargetingOffset = FMath::Lerp(Hierarchy->GetGlobalTransform(CachedLeftHandItem).GetLocation(),
-		                                Hierarchy->GetGlobalTransform(CachedRightHandItem).GetLocation(),
-		                                RetargetingWeight) -
-		                    FMath::Lerp(Hierarchy->GetGlobalTransform(CachedLeftHandIkItem).GetLocation(),
-		                                Hierarchy->GetGlobalTransform(CachedRightHandIkItem).GetLocation(),
-		                                RetargetingWeight);
-	}
-
-	RetargetingOffset *= FMath::Min(1.0f, Weight);
+	const auto RetargetingOffset{
+		CalculateRetargetingOffset(Hierarchy->GetGlobalTransform(CachedLeftHandItem).GetLocation(),
+		                           Hierarchy->GetGlobalTransform(CachedLeftHandIkItem).GetLocation(),
+		                           Hierarchy->GetGlobalTransform(CachedRightHandItem).GetLocation(),
+		                           Hierarchy->GetGlobalTransform(CachedRightHandIkItem).GetLocation(),
+		                           RetargetingWeight, Weight)
+	};
 
 	if (RetargetingOffset.IsNearlyZero())
 	{
@@ -1,12 +1,18 @@
 #include "Notifies/AlsAnimNotify_FootstepEffects.h"
 
+#include "AlsAnimationInstance.h"
 #include "AlsCharacter.h"
+#include "AlsFootstepDecalSubsystem.h"
+#include "AlsFootstepEffectsSubsystem.h"
 #include "DrawDebugHelpers.h"
+#include "NiagaraDataChannel.h"
+#include "NiagaraDataChannelAccessor.h"
 #include "NiagaraFunctionLibrary.h"
 #include "Animation/AnimInstance.h"
 #include "Components/AudioComponent.h"
 #include "Components/DecalComponent.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "Engine/AssetManager.h"
 #include "Engine/World.h"
 #include "Kismet/GameplayStatics.h"
 #include "PhysicalMaterials/PhysicalMaterial.h"
@@ -19,6 +25,20 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AlsAnimNotify_FootstepEffects)
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Footsteps Without Loaded Effect Assets"), STAT_AlsFootstepsWithoutLoadedEffectAssets, STATGROUP_Als)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Footstep Surface Traces"), STAT_AlsFootstepSurfaceTraces, STATGROUP_Als)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Footstep Foot Ground Cache Hits"), STAT_AlsFootstepFootGroundCacheHits, STATGROUP_Als)
+
+void UAlsFootstepEffectsSettings::PostLoad()
+{
+	Super::PostLoad();
+
+	if (!HasAnyFlags(RF_ClassDefaultObject) && !IsRunningDedicatedServer())
+	{
+		LoadEffectAssetsAsync();
+	}
+}
+
 #if WITH_EDITOR
 void FAlsFootstepDecalSettings::PostEditChangeProperty(const FPropertyChangedEvent& ChangedEvent)
 {
@@ -50,12 +70,131 @@ void UAlsFootstepEffectsSettings::PostEditChangeProperty(FPropertyChangedEvent&
 		{
 			Tuple.Value.PostEditChangeProperty(ChangedEvent);
 		}
+
+		LoadEffectAssetsAsync();
 	}
 
 	Super::PostEditChangeProperty(ChangedEvent);
 }
+
+void UAlsFootstepEffectsSettings::PostEditUndo()
+{
+	Super::PostEditUndo();
+
+	// Undo restores the effects map without calling PostEditChangeProperty(), so the compiled effects must be rebuilt here.
+
+	DecalSpawnAngleThresholdCos = FMath::Cos(FMath::DegreesToRadians(DecalSpawnAngleThreshold));
+
+	LoadEffectAssetsAsync();
+}
 #endif
 
+void UAlsFootstepEffectsSettings::LoadEffectAssetsAsync()
+{
+	// The asset manager may not be initialized yet if the settings are loaded during engine startup. In
+	// this case, loading will be requested again by the first footstep notify that uses these settings.
+
+	if (!UAssetManager::IsInitialized())
+	{
+		return;
+	}
+
+	if (EffectAssetsStreamingHandle.IsValid())
+	{
+		EffectAssetsStreamingHandle->CancelHandle();
+		EffectAssetsStreamingHandle.Reset();
+	}
+
+	// The effects map may have been changed, so discard the compiled effects until they are compiled again.
+
+	CompiledEffects.Reset();
+
+	TArray<FSoftObjectPath> AssetPaths;
+
+	for (const auto& [SurfaceType, EffectSettings] : Effects)
+	{
+		if (!EffectSettings.Sound.Sound.IsNull())
+		{
+			AssetPaths.AddUnique(EffectSettings.Sound.Sound.ToSoftObjectPath());
+		}
+
+		if (!EffectSettings.Decal.DecalMaterial.IsNull())
+		{
+			AssetPaths.AddUnique(EffectSettings.Decal.DecalMaterial.ToSoftObjectPath());
+		}
+
+		if (!EffectSettings.ParticleSystem.ParticleSystem.IsNull())
+		{
+			AssetPaths.AddUnique(EffectSettings.ParticleSystem.ParticleSystem.ToSoftObjectPath());
+		}
+
+		if (!EffectSettings.ParticleSystem.DataChannel.IsNull())
+		{
+			AssetPaths.AddUnique(EffectSettings.ParticleSystem.DataChannel.ToSoftObjectPath());
+		}
+	}
+
+	bEffectAssetsLoadingRequested = true;
+
+	if (AssetPaths.IsEmpty())
+	{
+		CompileEffects();
+		return;
+	}
+
+	EffectAssetsStreamingHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		MoveTemp(AssetPaths), FStreamableDelegate::CreateUObject(this, &ThisClass::CompileEffects));
+}
+
+void UAlsFootstepEffectsSettings::CompileEffects()
+{
+	CompiledEffects.Reset(SurfaceType_Max);
+	CompiledEffects.SetNum(SurfaceType_Max);
+
+	if (Effects.IsEmpty())
+	{
+		return;
+	}
+
+	const auto CompileEffect{
+		[](FAlsCompiledFootstepEffect& Effect, const EPhysicalSurface SurfaceType, const FAlsFootstepEffectSettings& EffectSettings)
+		{
+			Effect.SurfaceType = SurfaceType;
+			Effect.Settings = EffectSettings;
+
+			Effect.Sound = EffectSettings.Sound.Sound.Get();
+			Effect.DecalMaterial = EffectSettings.Decal.DecalMaterial.Get();
+			Effect.ParticleSystem = EffectSettings.ParticleSystem.ParticleSystem.Get();
+			Effect.ParticleSystemDataChannel = EffectSettings.ParticleSystem.DataChannel.Get();
+
+			Effect.bHasSound = IsValid(Effect.Sound);
+			Effect.bHasDecal = IsValid(Effect.DecalMaterial);
+			Effect.bHasParticleSystem = EffectSettings.ParticleSystem.SpawnMode == EAlsFootstepParticleEffectSpawnMode::WriteToDataChannel
+				                            ? IsValid(Effect.ParticleSystemDataChannel)
+				                            : IsValid(Effect.ParticleSystem);
+		}
+	};
+
+	// Surface types without their own effects use the first entry of the effects map.
+
+	auto FallbackIterator{Effects.CreateConstIterator()};
+	FAlsCompiledFootstepEffect FallbackEffect;
+	CompileEffect(FallbackEffect, FallbackIterator.Key(), FallbackIterator.Value());
+
+	for (auto& Effect : CompiledEffects)
+	{
+		Effect = FallbackEffect;
+	}
+
+	for (const auto& [SurfaceType, EffectSettings] : Effects)
+	{
+		if (CompiledEffects.IsValidIndex(SurfaceType))
+		{
+			CompileEffect(CompiledEffects[SurfaceType], SurfaceType, EffectSettings);
+		}
+	}
+}
+
 FString UAlsAnimNotify_FootstepEffects::GetNotifyName_Implementation() const
 {
 	TStringBuilder<64> NotifyNameBuilder{InPlace, TEXTVIEW("Als Footstep Effects: "), AlsEnumUtility::GetNameStringByValue(FootBone)};
@@ -105,21 +244,53 @@ void UAlsAnimNotify_FootstepEffects::Notify(USkeletalMeshComponent* Mesh, UAnimS
 			                                     : FVector{FootstepEffectsSettings->FootRightZAxis})
 	};
 
-	FCollisionQueryParams QueryParameters{__FUNCTION__, true, Mesh->GetOwner()};
-	QueryParameters.bReturnPhysicalMaterial = true;
+	// Decide which effects are worth spawning before doing anything expensive, so
+	// that insignificant footsteps don't even trace for the surface underfoot.
+
+	FAlsFootstepSignificance Significance;
+
+	auto* EffectsSubsystem{World->GetSubsystem<UAlsFootstepEffectsSubsystem>()};
+
+	if (IsValid(EffectsSubsystem))
+	{
+		Significance = EffectsSubsystem->EvaluateFootstepSignificance(Mesh, FootTransform.GetLocation(),
+		                                                              FootstepEffectsSettings->Significance);
+	}
+
+	Significance.bSound &= bSpawnSound;
+	Significance.bDecal &= bSpawnDecal;
+	Significance.bParticleSystem &= bSpawnParticleSystem;
+
+	if (!Significance.IsAnySignificant())
+	{
+		return;
+	}
 
 	FHitResult FootstepHit;
-	if (!World->LineTraceSingleByChannel(FootstepHit, FootTransform.GetLocation(),
-	                                     FootTransform.GetLocation() - FootZAxis *
-	                                     (FootstepEffectsSettings->SurfaceTraceDistance * MeshScale),
-	                                     FootstepEffectsSettings->SurfaceTraceChannel, QueryParameters))
+
+	if (TryGetFootGroundCacheHit(Mesh, FootTransform.GetLocation(), FootstepHit))
 	{
-		// As a fallback, trace down the world Z axis if the first trace didn't hit anything.
+		INC_DWORD_STAT(STAT_AlsFootstepFootGroundCacheHits)
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_AlsFootstepSurfaceTraces)
+
+		FCollisionQueryParams QueryParameters{__FUNCTION__, true, Mesh->GetOwner()};
+		QueryParameters.bReturnPhysicalMaterial = true;
+
+		if (!World->LineTraceSingleByChannel(FootstepHit, FootTransform.GetLocation(),
+		                                     FootTransform.GetLocation() - FootZAxis *
+		                                     (FootstepEffectsSettings->SurfaceTraceDistance * MeshScale),
+		                                     FootstepEffectsSettings->SurfaceTraceChannel, QueryParameters))
+		{
+			// As a fallback, trace down the world Z axis if the first trace didn't hit anything.
 
-		World->LineTraceSingleByChannel(FootstepHit, FootTransform.GetLocation(),
-		                                FootTransform.GetLocation() - FVector{
-			                                0.0f, 0.0f, FootstepEffectsSettings->SurfaceTraceDistance * MeshScale
-		                                }, FootstepEffectsSettings->SurfaceTraceChannel, QueryParameters);
+			World->LineTraceSingleByChannel(FootstepHit, FootTransform.GetLocation(),
+			                                FootTransform.GetLocation() - FVector{
+				                                0.0f, 0.0f, FootstepEffectsSettings->SurfaceTraceDistance * MeshScale
+			                                }, FootstepEffectsSettings->SurfaceTraceChannel, QueryParameters);
+		}
 	}
 
 #if ENABLE_DRAW_DEBUG
@@ -135,21 +306,30 @@ void UAlsAnimNotify_FootstepEffects::Notify(USkeletalMeshComponent* Mesh, UAnimS
 		return;
 	}
 
-	const auto SurfaceType{FootstepHit.PhysMaterial.IsValid() ? FootstepHit.PhysMaterial->SurfaceType.GetValue() : SurfaceType_Default};
-	const auto* EffectSettings{FootstepEffectsSettings->Effects.Find(SurfaceType)};
+	// Never load effect assets synchronously, as this causes a hitch. Instead, skip
+	// the effects and wait for the asynchronous loading of the assets to complete.
+
+	const auto* Effect{
+		FootstepEffectsSettings->FindCompiledEffect(FootstepHit.PhysMaterial.IsValid()
+			                                            ? FootstepHit.PhysMaterial->SurfaceType.GetValue()
+			                                            : SurfaceType_Default)
+	};
 
-	if (EffectSettings == nullptr)
+	if (Effect == nullptr)
 	{
-		for (const auto& Tuple : FootstepEffectsSettings->Effects)
-		{
-			EffectSettings = &Tuple.Value;
-			break;
-		}
+		INC_DWORD_STAT(STAT_AlsFootstepsWithoutLoadedEffectAssets)
 
-		if (EffectSettings == nullptr)
+		if (!FootstepEffectsSettings->IsEffectAssetsLoadingRequested())
 		{
-			return;
+			FootstepEffectsSettings->LoadEffectAssetsAsync();
 		}
+
+		return;
+	}
+
+	if (!Effect->bHasSound && !Effect->bHasDecal && !Effect->bHasParticleSystem)
+	{
+		return;
 	}
 
 	const auto FootstepLocation{FootstepHit.ImpactPoint};
@@ -169,23 +349,74 @@ void UAlsAnimNotify_FootstepEffects::Notify(USkeletalMeshComponent* Mesh, UAnimS
 	}
 #endif
 
-	if (bSpawnSound)
+	if (Significance.bSound && Effect->bHasSound)
+	{
+		SpawnSound(Mesh, EffectsSubsystem, Effect->Settings.Sound, Effect->Sound, FootstepLocation, FootstepRotation);
+	}
+
+	if (Significance.bDecal && Effect->bHasDecal)
+	{
+		SpawnDecal(Mesh, Effect->Settings.Decal, Effect->DecalMaterial, Effect->SurfaceType,
+		           FootstepLocation, FootstepRotation, FootstepHit, FootZAxis);
+	}
+
+	if (Significance.bParticleSystem && Effect->bHasParticleSystem)
+	{
+		SpawnParticleSystem(Mesh, Effect->Settings.ParticleSystem, *Effect, FootstepLocation, FootstepRotation);
+	}
+}
+
+bool UAlsAnimNotify_FootstepEffects::TryGetFootGroundCacheHit(const USkeletalMeshComponent* Mesh, const FVector& FootLocation,
+                                                              FHitResult& FootstepHit) const
+{
+	if (FootstepEffectsSettings->FootGroundCacheMaxAge <= 0.0f)
 	{
-		SpawnSound(Mesh, EffectSettings->Sound, FootstepLocation, FootstepRotation);
+		return false;
 	}
 
-	if (bSpawnDecal)
+	const auto* AnimationInstance{Cast<UAlsAnimationInstance>(Mesh->GetAnimInstance())};
+
+	if (!IsValid(AnimationInstance))
 	{
-		SpawnDecal(Mesh, EffectSettings->Decal, FootstepLocation, FootstepRotation, FootstepHit, FootZAxis);
+		return false;
 	}
 
-	if (bSpawnParticleSystem)
+	const auto& FootGroundHit{AnimationInstance->GetFootGroundHit(FootBone)};
+
+	if (!FootGroundHit.bValid || Mesh->GetWorld()->GetTimeSeconds() - FootGroundHit.Time > FootstepEffectsSettings->FootGroundCacheMaxAge)
 	{
-		SpawnParticleSystem(Mesh, EffectSettings->ParticleSystem, FootstepLocation, FootstepRotation);
+		return false;
 	}
+
+	// Make sure that the cached hit is still under the foot and
+	// within the range that the surface trace would have covered.
+
+	const auto MeshScale{Mesh->GetComponentScale().Z};
+	const auto FootHeight{FootLocation.Z - FootGroundHit.ImpactPoint.Z};
+
+	if (FVector::DistSquaredXY(FootLocation, FootGroundHit.ImpactPoint) >
+	    FMath::Square(FootstepEffectsSettings->FootGroundCacheMaxDistance * MeshScale) ||
+	    FootHeight < -FootstepEffectsSettings->FootGroundCacheMaxDistance * MeshScale ||
+	    FootHeight > FootstepEffectsSettings->SurfaceTraceDistance * MeshScale)
+	{
+		return false;
+	}
+
+	FootstepHit.bBlockingHit = true;
+	FootstepHit.TraceStart = FootGroundHit.TraceStart;
+	FootstepHit.TraceEnd = FootGroundHit.TraceEnd;
+	FootstepHit.Location = FootGroundHit.ImpactPoint;
+	FootstepHit.ImpactPoint = FootGroundHit.ImpactPoint;
+	FootstepHit.Normal = FootGroundHit.ImpactNormal;
+	FootstepHit.ImpactNormal = FootGroundHit.ImpactNormal;
+	FootstepHit.Component = FootGroundHit.Component;
+	FootstepHit.PhysMaterial = FootGroundHit.PhysicalMaterial;
+
+	return true;
 }
 
-void UAlsAnimNotify_FootstepEffects::SpawnSound(USkeletalMeshComponent* Mesh, const FAlsFootstepSoundSettings& SoundSettings,
+void UAlsAnimNotify_FootstepEffects::SpawnSound(USkeletalMeshComponent* Mesh, UAlsFootstepEffectsSubsystem* EffectsSubsystem,
+                                                const FAlsFootstepSoundSettings& SoundSettings, USoundBase* Sound,
                                                 const FVector& FootstepLocation, const FQuat& FootstepRotation) const
 {
 	auto VolumeMultiplier{SoundVolumeMultiplier};
@@ -195,11 +426,33 @@ void UAlsAnimNotify_FootstepEffects::SpawnSound(USkeletalMeshComponent* Mesh, co
 		VolumeMultiplier *= 1.0f - UAlsMath::Clamp01(Mesh->GetAnimInstance()->GetCurveValue(UAlsConstants::FootstepSoundBlockCurveName()));
 	}
 
-	if (!FAnimWeight::IsRelevant(VolumeMultiplier) || !IsValid(SoundSettings.Sound.LoadSynchronous()))
+	if (!FAnimWeight::IsRelevant(VolumeMultiplier) || !IsValid(Sound))
 	{
 		return;
 	}
 
+	const auto& FootBoneName{
+		FootBone == EAlsFootBone::Left ? UAlsConstants::FootLeftBoneName() : UAlsConstants::FootRightBoneName()
+	};
+
+	if (IsValid(EffectsSubsystem))
+	{
+		auto* Audio{
+			SoundSettings.SpawnMode == EAlsFootstepSoundSpawnMode::SpawnAttachedToFootBone
+				? EffectsSubsystem->AcquireAudioComponent(Mesh, FootBoneName, FVector::ZeroVector, FRotator::ZeroRotator)
+				: EffectsSubsystem->AcquireAudioComponent(nullptr, NAME_None, FootstepLocation, FootstepRotation.Rotator())
+		};
+
+		Audio->SetSound(Sound);
+		Audio->VolumeMultiplier = VolumeMultiplier;
+		Audio->PitchMultiplier = SoundPitchMultiplier;
+		Audio->SetIntParameter(FName{TEXTVIEW("FootstepType")}, static_cast<int32>(SoundType));
+		Audio->Play();
+		return;
+	}
+
+	// Footstep audio pooling is not available in editor preview worlds, so spawn a standalone sound here.
+
 	UAudioComponent* Audio{nullptr};
 
 	if (SoundSettings.SpawnMode == EAlsFootstepSoundSpawnMode::SpawnAtTraceHitLocation)
@@ -208,23 +461,19 @@ void UAlsAnimNotify_FootstepEffects::SpawnSound(USkeletalMeshComponent* Mesh, co
 
 		if (World->WorldType == EWorldType::EditorPreview)
 		{
-			UGameplayStatics::PlaySoundAtLocation(World, SoundSettings.Sound.Get(), FootstepLocation,
+			UGameplayStatics::PlaySoundAtLocation(World, Sound, FootstepLocation,
 			                                      VolumeMultiplier, SoundPitchMultiplier);
 		}
 		else
 		{
-			Audio = UGameplayStatics::SpawnSoundAtLocation(World, SoundSettings.Sound.Get(), FootstepLocation,
+			Audio = UGameplayStatics::SpawnSoundAtLocation(World, Sound, FootstepLocation,
 			                                               FootstepRotation.Rotator(),
 			                                               VolumeMultiplier, SoundPitchMultiplier);
 		}
 	}
 	else if (SoundSettings.SpawnMode == EAlsFootstepSoundSpawnMode::SpawnAttachedToFootBone)
 	{
-		const auto& FootBoneName{
-			FootBone == EAlsFootBone::Left ? UAlsConstants::FootLeftBoneName() : UAlsConstants::FootRightBoneName()
-		};
-
-		Audio = UGameplayStatics::SpawnSoundAttached(SoundSettings.Sound.Get(), Mesh, FootBoneName, FVector::ZeroVector,
+		Audio = UGameplayStatics::SpawnSoundAttached(Sound, Mesh, FootBoneName, FVector::ZeroVector,
 		                                             FRotator::ZeroRotator, EAttachLocation::SnapToTarget,
 		                                             true, VolumeMultiplier, SoundPitchMultiplier);
 	}
@@ -236,6 +485,7 @@ void UAlsAnimNotify_FootstepEffects::SpawnSound(USkeletalMeshComponent* Mesh, co
 }
 
 void UAlsAnimNotify_FootstepEffects::SpawnDecal(USkeletalMeshComponent* Mesh, const FAlsFootstepDecalSettings& DecalSettings,
+                                                UMaterialInterface* DecalMaterial, const EPhysicalSurface SurfaceType,
                                                 const FVector& FootstepLocation, const FQuat& FootstepRotation,
                                                 const FHitResult& FootstepHit, const FVector& FootZAxis) const
 {
@@ -244,7 +494,7 @@ void UAlsAnimNotify_FootstepEffects::SpawnDecal(USkeletalMeshComponent* Mesh, co
 		return;
 	}
 
-	if (!IsValid(DecalSettings.DecalMaterial.LoadSynchronous()))
+	if (!IsValid(DecalMaterial))
 	{
 		return;
 	}
@@ -263,17 +513,34 @@ void UAlsAnimNotify_FootstepEffects::SpawnDecal(USkeletalMeshComponent* Mesh, co
 		FootstepLocation + DecalRotation.RotateVector(FVector{DecalSettings.LocationOffset} * MeshScale)
 	};
 
+	auto* DecalSubsystem{Mesh->GetWorld()->GetSubsystem<UAlsFootstepDecalSubsystem>()};
+
+	if (IsValid(DecalSubsystem))
+	{
+		auto* AttachParent{
+			DecalSettings.SpawnMode == EAlsFootstepDecalSpawnMode::SpawnAttachedToTraceHitComponent
+				? FootstepHit.Component.Get()
+				: nullptr
+		};
+
+		DecalSubsystem->SpawnDecal(DecalSettings, DecalMaterial, SurfaceType, FVector{DecalSettings.Size} * MeshScale,
+		                           DecalLocation, DecalRotation.Rotator(), AttachParent);
+		return;
+	}
+
+	// Footstep decal pooling is not available in editor preview worlds, so spawn a standalone decal here.
+
 	UDecalComponent* Decal{nullptr};
 
 	if (DecalSettings.SpawnMode == EAlsFootstepDecalSpawnMode::SpawnAtTraceHitLocation || !FootstepHit.Component.IsValid())
 	{
-		Decal = UGameplayStatics::SpawnDecalAtLocation(Mesh->GetWorld(), DecalSettings.DecalMaterial.Get(),
+		Decal = UGameplayStatics::SpawnDecalAtLocation(Mesh->GetWorld(), DecalMaterial,
 		                                               FVector{DecalSettings.Size} * MeshScale,
 		                                               DecalLocation, DecalRotation.Rotator());
 	}
 	else if (DecalSettings.SpawnMode == EAlsFootstepDecalSpawnMode::SpawnAttachedToTraceHitComponent)
 	{
-		Decal = UGameplayStatics::SpawnDecalAttached(DecalSettings.DecalMaterial.Get(),
+		Decal = UGameplayStatics::SpawnDecalAttached(DecalMaterial,
 		                                             FVector{DecalSettings.Size} * MeshScale,
 		                                             FootstepHit.Component.Get(), NAME_None, DecalLocation,
 		                                             DecalRotation.Rotator(), EAttachLocation::KeepWorldPosition);
@@ -287,14 +554,34 @@ void UAlsAnimNotify_FootstepEffects::SpawnDecal(USkeletalMeshComponent* Mesh, co
 
 void UAlsAnimNotify_FootstepEffects::SpawnParticleSystem(USkeletalMeshComponent* Mesh,
                                                          const FAlsFootstepParticleSystemSettings& ParticleSystemSettings,
-                                                         const FVector& FootstepLocation, const FQuat& FootstepRotation) const
+                                                         const FAlsCompiledFootstepEffect& Effect, const FVector& FootstepLocation,
+                                                         const FQuat& FootstepRotation) const
 {
-	if (!IsValid(ParticleSystemSettings.ParticleSystem.LoadSynchronous()))
+	const auto MeshScale{Mesh->GetComponentScale().Z};
+
+	if (ParticleSystemSettings.SpawnMode == EAlsFootstepParticleEffectSpawnMode::WriteToDataChannel)
 	{
+		const auto ParticleSystemRotation{
+			FootstepRotation * FQuat{
+				FootBone == EAlsFootBone::Left
+					? ParticleSystemSettings.FootLeftRotationOffsetQuaternion
+					: ParticleSystemSettings.FootRightRotationOffsetQuaternion
+			}
+		};
+
+		WriteParticleSystemDataChannel(Mesh, Effect.ParticleSystemDataChannel, Effect.SurfaceType,
+		                               FootstepLocation + ParticleSystemRotation.RotateVector(
+			                               FVector{ParticleSystemSettings.LocationOffset} * MeshScale),
+		                               FootstepRotation);
 		return;
 	}
 
-	const auto MeshScale{Mesh->GetComponentScale().Z};
+	auto* ParticleSystem{Effect.ParticleSystem.Get()};
+
+	if (!IsValid(ParticleSystem))
+	{
+		return;
+	}
 
 	if (ParticleSystemSettings.SpawnMode == EAlsFootstepParticleEffectSpawnMode::SpawnAtTraceHitLocation)
 	{
@@ -311,7 +598,7 @@ void UAlsAnimNotify_FootstepEffects::SpawnParticleSystem(USkeletalMeshComponent*
 			ParticleSystemRotation.RotateVector(FVector{ParticleSystemSettings.LocationOffset} * MeshScale)
 		};
 
-		UNiagaraFunctionLibrary::SpawnSystemAtLocation(Mesh->GetWorld(), ParticleSystemSettings.ParticleSystem.Get(),
+		UNiagaraFunctionLibrary::SpawnSystemAtLocation(Mesh->GetWorld(), ParticleSystem,
 		                                               ParticleSystemLocation, ParticleSystemRotation.Rotator(),
 		                                               FVector::OneVector * MeshScale, true, true, ENCPoolMethod::AutoRelease);
 	}
@@ -319,7 +606,7 @@ void UAlsAnimNotify_FootstepEffects::SpawnParticleSystem(USkeletalMeshComponent*
 	{
 		const auto& FootBoneName{FootBone == EAlsFootBone::Left ? UAlsConstants::FootLeftBoneName() : UAlsConstants::FootRightBoneName()};
 
-		UNiagaraFunctionLibrary::SpawnSystemAttached(ParticleSystemSettings.ParticleSystem.Get(), Mesh, FootBoneName,
+		UNiagaraFunctionLibrary::SpawnSystemAttached(ParticleSystem, Mesh, FootBoneName,
 		                                             FVector{ParticleSystemSettings.LocationOffset} * MeshScale,
 		                                             FRotator{
 			                                             FootBone == EAlsFootBone::Left
@@ -330,3 +617,43 @@ void UAlsAnimNotify_FootstepEffects::SpawnParticleSystem(USkeletalMeshComponent*
 		                                             true, ENCPoolMethod::AutoRelease);
 	}
 }
+
+void UAlsAnimNotify_FootstepEffects::WriteParticleSystemDataChannel(USkeletalMeshComponent* Mesh, UNiagaraDataChannelAsset* DataChannel,
+                                                                    const EPhysicalSurface SurfaceType,
+                                                                    const FVector& ParticleSystemLocation,
+                                                                    const FQuat& FootstepRotation) const
+{
+	if (!IsValid(DataChannel))
+	{
+		return;
+	}
+
+	FNiagaraDataChannelSearchParameters SearchParameters;
+	SearchParameters.OwningComponent = Mesh;
+	SearchParameters.Location = ParticleSystemLocation;
+
+	// Footsteps are only rendered, so there is no need to make them visible to the game thread. The debug
+	// source and the variable names are constructed once, so that writing doesn't allocate per footstep.
+
+	static const FString DebugSource{TEXTVIEW("Als Footstep Effects")};
+
+	auto* Writer{
+		UNiagaraDataChannelLibrary::WriteToNiagaraDataChannel(Mesh, DataChannel, SearchParameters, 1,
+		                                                      false, true, true, DebugSource)
+	};
+
+	if (Writer == nullptr)
+	{
+		return;
+	}
+
+	static const FName PositionName{TEXTVIEW("Position")};
+	static const FName NormalName{TEXTVIEW("Normal")};
+	static const FName SurfaceTypeName{TEXTVIEW("SurfaceType")};
+	static const FName IntensityName{TEXTVIEW("Intensity")};
+
+	Writer->WritePosition(PositionName, 0, ParticleSystemLocation);
+	Writer->WriteVector(NormalName, 0, FootstepRotation.GetUpVector());
+	Writer->WriteInt(SurfaceTypeName, 0, static_cast<int32>(SurfaceType));
+	Writer->WriteFloat(IntensityName, 0, ParticleSystemIntensity);
+}
@@ -6,6 +6,7 @@
 #include "State/AlsCrouchingState.h"
 #include "State/AlsDynamicTransitionsState.h"
 #include "State/AlsFeetState.h"
+#include "State/AlsFootGroundCache.h"
 #include "State/AlsGroundedState.h"
 #include "State/AlsInAirState.h"
 #include "State/AlsLayeringState.h"
@@ -75,6 +76,30 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
 	FGameplayTag OverlayMode{AlsOverlayModeTags::Default};
 
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
+	TSubclassOf<UAnimInstance> LinkedOverlayLayerClass;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
+	TObjectPtr<UAnimInstance> LinkedOverlayLayerInstance;
+
+	// Pool of pre-initialized overlay layer instances. Only the linked instance is registered
+	// with the skeletal mesh, so the other instances are not updated while idle.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
+	TArray<TObjectPtr<UAnimInstance>> OverlayLayerInstances;
+
+	// Set when the layer class or the prefetched layer classes change, and cleared once the pool is refreshed.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
+	uint8 bOverlayLayerInstancesRefreshPending : 1 {false};
+
+	// Most recently used overlay layer classes, the first one is the current
+	// one. They are kept resident by the overlay streaming subsystem.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
+	TArray<TSoftClassPtr<UAnimInstance>> RecentOverlayLayerClasses;
+
+	// Overlay layer classes that the character is likely to switch to, for example, based on the contents of its inventory.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
+	TArray<TSoftClassPtr<UAnimInstance>> PrefetchedOverlayLayerClasses;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
 	FGameplayTag LocomotionAction;
 
@@ -120,6 +145,11 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
 	FAlsFeetState FeetState;
 
+	// Written by the foot offset trace rig unit during animation evaluation and
+	// read by the footstep effects notify when queued notifies are dispatched.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
+	FAlsFootGroundCache FootGroundCache;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
 	FAlsTransitionsState TransitionsState;
 
@@ -146,6 +176,8 @@ public:
 
 	virtual void NativePostUpdateAnimation();
 
+	virtual void NativeUninitializeAnimation() override;
+
 protected:
 	virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override;
 
@@ -285,6 +317,11 @@ private:
 	void RefreshFootLock(float IkAmount, FAlsFootState& FootState, const FName& LockCurveName,
 	                     const FTransform& ComponentTransformInverse, float DeltaTime) const;
 
+public:
+	const FAlsFootGroundHit& GetFootGroundHit(EAlsFootBone FootBone) const;
+
+	void SetFootGroundHit(EAlsFootBone FootBone, const FHitResult& Hit);
+
 	// Transitions
 
 public:
@@ -341,6 +378,37 @@ protected:
 private:
 	void PlayQueuedTurnInPlaceAnimation();
 
+	// Overlay Layers
+
+public:
+	// Starts streaming the layer classes of the given overlay modes and keeps them resident until the next call, so
+	// that switching to them doesn't have to wait for streaming. Pass an empty container to release all of them.
+	UFUNCTION(BlueprintCallable, Category = "ALS|Animation Instance")
+	void PrefetchOverlayLayers(const FGameplayTagContainer& OverlayModes);
+
+	// Returns the estimated memory used by the animations of the overlay layer classes kept resident by this character.
+	UFUNCTION(BlueprintPure, Category = "ALS|Animation Instance", Meta = (ReturnDisplayName = "Memory"))
+	int64 GetResidentOverlayLayersMemory() const;
+
+private:
+	void RefreshOverlayLayersOnGameThread();
+
+	void AddRecentOverlayLayerClass(const TSoftClassPtr<UAnimInstance>& LayerClass);
+
+	void ReleaseOverlayLayerClasses();
+
+	void RelinkOverlayLayers(UClass* NewLayerClass);
+
+	void RefreshOverlayLayerInstances();
+
+	UAnimInstance* CreateOverlayLayerInstance(UClass* LayerClass);
+
+	UAnimInstance* FindOverlayLayerInstance(const UClass* LayerClass) const;
+
+	void LinkOverlayLayerInstance(UAnimInstance* NewInstance);
+
+	void ReleaseOverlayLayerInstances();
+
 	// Ragdolling
 
 private:
@@ -394,3 +462,8 @@ inline void UAlsAnimationInstance::Jump()
 {
 	InAirState.bJumpRequested = true;
 }
+
+inline const FAlsFootGroundHit& UAlsAnimationInstance::GetFootGroundHit(const EAlsFootBone FootBone) const
+{
+	return FootBone == EAlsFootBone::Left ? FootGroundCache.Left : FootGroundCache.Right;
+}
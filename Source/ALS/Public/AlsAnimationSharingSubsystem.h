@@ -0,0 +1,99 @@
+#pragma once
+
+#include "GameplayTagContainer.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AlsAnimationSharingSubsystem.generated.h"
+
+class AAlsCharacter;
+class USkinnedAsset;
+
+// Discretized state of a character. Characters with equal keys are considered to play the same animations.
+struct ALS_API FAlsAnimationSharingKey
+{
+	const USkinnedAsset* SkinnedAsset{nullptr};
+
+	const UClass* AnimationInstanceClass{nullptr};
+
+	FGameplayTag LocomotionMode;
+
+	FGameplayTag RotationMode;
+
+	FGameplayTag Stance;
+
+	FGameplayTag Gait;
+
+	FGameplayTag OverlayMode;
+
+	int32 SpeedBucket{0};
+
+	int32 DirectionBucket{INDEX_NONE};
+
+public:
+	bool operator==(const FAlsAnimationSharingKey& Other) const = default;
+
+	friend uint32 GetTypeHash(const FAlsAnimationSharingKey& Key);
+};
+
+struct ALS_API FAlsAnimationSharingCharacter
+{
+	TWeakObjectPtr<AAlsCharacter> Character;
+
+	// Character whose pose this character copies. Not set if the character evaluates its own animation blueprint.
+	TWeakObjectPtr<AAlsCharacter> Leader;
+
+	FAlsAnimationSharingKey Key;
+
+	uint8 bShared : 1 {false};
+
+	uint8 bEligible : 1 {false};
+
+	// Whether the character's mesh keeps ticking its pose, which is required for the followers to have a pose to copy.
+	uint8 bCanLead : 1 {false};
+};
+
+// Groups distant characters by their discretized locomotion state. One leader per group evaluates its animation
+// blueprint, while the other characters in the group copy its component space pose through the leader pose component.
+// Since the pose is copied in component space, each follower keeps its own root transform. A character leaves its group
+// as soon as it comes closer to a local player camera, starts a locomotion action (such as mantling or ragdolling),
+// starts playing a montage, or its state changes so that it no longer matches the group. Only characters whose meshes keep
+// ticking their poses can lead, so characters that tick their poses only when rendered can lead only while they are rendered.
+// While following, characters read the animation curves that drive their rotation from the animation instance of the leader.
+UCLASS()
+class ALS_API UAlsAnimationSharingSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+private:
+	TArray<FAlsAnimationSharingCharacter> Characters;
+
+	// Reused every tick to avoid allocations.
+	TMap<FAlsAnimationSharingKey, int32> LeaderIndices;
+
+	TArray<FVector> ViewLocations;
+
+public:
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+
+public:
+	void AddCharacter(AAlsCharacter* Character);
+
+	void RemoveCharacter(AAlsCharacter* Character);
+
+private:
+	void RefreshViewLocations();
+
+	bool IsEligible(const FAlsAnimationSharingCharacter& SharingCharacter) const;
+
+	static bool TryGetSharingKey(const AAlsCharacter* Character, FAlsAnimationSharingKey& Key);
+
+	static bool CanLead(const AAlsCharacter* Character);
+
+	static void SetLeader(FAlsAnimationSharingCharacter& SharingCharacter, AAlsCharacter* NewLeader);
+};
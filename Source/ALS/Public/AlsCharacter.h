@@ -128,6 +128,8 @@ public:
 protected:
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
+
 	virtual void CalcCamera(float DeltaTime, FMinimalViewInfo& ViewInfo) override;
 
 public:
@@ -444,6 +446,8 @@ protected:
 	bool ConstrainAimingRotation(FRotator& ActorRotation, float DeltaTime, bool bApplySecondaryConstraint = false);
 
 private:
+	float GetRotationAnimationCurveValue(const FName& CurveName) const;
+
 	void ApplyRotationYawSpeedAnimationCurve(float DeltaTime);
 
 	void RefreshInAirRotation(float DeltaTime);
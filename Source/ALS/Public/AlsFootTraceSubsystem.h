@@ -0,0 +1,59 @@
+#pragma once
+
+#include "WorldCollision.h"
+#include "Engine/HitResult.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "State/AlsFootGroundCache.h"
+#include "AlsFootTraceSubsystem.generated.h"
+
+struct FAlsFootTrace
+{
+	FVector TraceStart{ForceInit};
+
+	FVector TraceEnd{ForceInit};
+
+	TEnumAsByte<ECollisionChannel> TraceChannel{ECC_Visibility};
+
+	TWeakObjectPtr<const AActor> IgnoredActor;
+
+	FTraceHandle TraceHandle;
+
+	// Result of the latest completed asynchronous trace.
+	FHitResult Hit;
+
+	uint64 RequestFrameNumber{0};
+
+	bool bHitValid{false};
+
+	bool bRequestPending{false};
+};
+
+// Performs foot traces of all characters asynchronously. Foot traces requested during animation evaluation are
+// submitted all at once on the game thread, and their results are available on the next frame. Unlike synchronous
+// traces, this doesn't block animation worker threads on scene queries.
+UCLASS()
+class ALS_API UAlsFootTraceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+private:
+	FCriticalSection TracesCriticalSection;
+
+	TMap<TPair<TObjectKey<USceneComponent>, EAlsFootBone>, FAlsFootTrace> Traces;
+
+public:
+	virtual TStatId GetStatId() const override;
+
+	virtual void Tick(float DeltaTime) override;
+
+protected:
+	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+
+public:
+	// Thread safe. Requests an asynchronous trace for the next frame and returns the result of the previous one, moved
+	// along the hit surface to the current trace. Returns false if the result is not available or the foot has moved
+	// too far since the previous trace, in which case the caller is expected to perform a synchronous trace.
+	bool TryGetFootTraceHit(const USceneComponent* Component, EAlsFootBone FootBone, const FVector& TraceStart,
+	                        const FVector& TraceEnd, ECollisionChannel TraceChannel, const AActor* IgnoredActor,
+	                        float MaxExtrapolationDistance, FHitResult& Hit);
+};
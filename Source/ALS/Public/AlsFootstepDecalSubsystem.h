@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "AlsFootstepDecalSubsystem.generated.h"
+
+enum EPhysicalSurface : int;
+struct FAlsFootstepDecalSettings;
+class UDecalComponent;
+class UMaterialInterface;
+
+USTRUCT()
+struct ALS_API FAlsPooledFootstepDecal
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(Transient)
+	TObjectPtr<UDecalComponent> Decal;
+
+	UPROPERTY(Transient)
+	TEnumAsByte<EPhysicalSurface> SurfaceType;
+
+	// World time at which the decal has completely faded out.
+	UPROPERTY(Transient, Meta = (ForceUnits = "s"))
+	double ExpirationTime{0.0};
+};
+
+// Keeps a fixed-capacity ring buffer of footstep decal components per world. When the buffer is full,
+// the oldest decal is reused instead of spawning a new one, so that the number of decal components
+// stays bounded no matter how many characters are walking around.
+UCLASS()
+class ALS_API UAlsFootstepDecalSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+private:
+	UPROPERTY(Transient)
+	TArray<FAlsPooledFootstepDecal> Decals;
+
+	int32 NextDecalIndex{0};
+
+	int32 VisibleDecalsCount{0};
+
+public:
+	virtual TStatId GetStatId() const override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual void Deinitialize() override;
+
+protected:
+	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+
+public:
+	UDecalComponent* SpawnDecal(const FAlsFootstepDecalSettings& DecalSettings, UMaterialInterface* DecalMaterial,
+	                            EPhysicalSurface SurfaceType, const FVector& Size, const FVector& Location,
+	                            const FRotator& Rotation, USceneComponent* AttachParent);
+
+private:
+	bool IsWithinSpawnDistance(const FVector& Location, float MaxDistance) const;
+
+	int32 FindDecalIndexForSurface(EPhysicalSurface SurfaceType, int32 MaxSurfaceDecalsCount, double WorldTime) const;
+};
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "AlsFootstepEffectsSubsystem.generated.h"
+
+struct FAlsFootstepSignificanceSettings;
+class UAudioComponent;
+class USkeletalMeshComponent;
+
+USTRUCT(BlueprintType)
+struct ALS_API FAlsFootstepSignificance
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS")
+	uint8 bSound : 1 {true};
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS")
+	uint8 bDecal : 1 {true};
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS")
+	uint8 bParticleSystem : 1 {true};
+
+public:
+	bool IsAnySignificant() const;
+};
+
+inline bool FAlsFootstepSignificance::IsAnySignificant() const
+{
+	return bSound || bDecal || bParticleSystem;
+}
+
+USTRUCT()
+struct ALS_API FAlsFootstepViewer
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(Transient)
+	FVector ListenerLocation{ForceInit};
+
+	UPROPERTY(Transient)
+	FVector ViewLocation{ForceInit};
+
+	// Tangent of the half horizontal field of view, used to estimate the screen size of characters.
+	UPROPERTY(Transient)
+	float ViewHalfFovTangent{1.0f};
+};
+
+USTRUCT()
+struct ALS_API FAlsFootstepAudioComponent
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(Transient)
+	TObjectPtr<UAudioComponent> AudioComponent;
+
+	// World time at which the audio component was last acquired.
+	UPROPERTY(Transient)
+	double AcquireTime{0.0};
+};
+
+// Decides per footstep which effects are worth spawning, based on the distance to local audio listeners and
+// cameras, the on-screen size of the character and a global per-frame footstep budget. Also keeps a pool of
+// audio components for footstep sounds, so that playing a footstep doesn't allocate a new component each time.
+UCLASS()
+class ALS_API UAlsFootstepEffectsSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+private:
+	UPROPERTY(Transient)
+	TArray<FAlsFootstepViewer> Viewers;
+
+	UPROPERTY(Transient)
+	TArray<FAlsFootstepAudioComponent> AudioComponents;
+
+	uint64 ViewersFrameNumber{0};
+
+	int32 FrameFootstepsCount{0};
+
+public:
+	virtual void Deinitialize() override;
+
+protected:
+	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+
+public:
+	FAlsFootstepSignificance EvaluateFootstepSignificance(const USkeletalMeshComponent* Mesh, const FVector& FootstepLocation,
+	                                                      const FAlsFootstepSignificanceSettings& SignificanceSettings);
+
+	// Returns an idle pooled audio component placed at the given location, or attached to the given parent. The
+	// caller is expected to set up the sound and call UAudioComponent::Play(). Never returns null.
+	UAudioComponent* AcquireAudioComponent(USceneComponent* AttachParent, FName AttachSocketName,
+	                                       const FVector& Location, const FRotator& Rotation);
+
+private:
+	void RefreshFrame();
+
+	void RefreshViewers();
+
+	int32 FindAudioComponentToSteal() const;
+
+	void OnAudioFinished(UAudioComponent* AudioComponent);
+
+	UFUNCTION()
+	void OnAttachParentOwnerDestroyed(AActor* DestroyedActor);
+};
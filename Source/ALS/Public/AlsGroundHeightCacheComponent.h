@@ -0,0 +1,150 @@
+#pragma once
+
+#include "Components/ActorComponent.h"
+#include "Engine/EngineTypes.h"
+#include "Engine/HitResult.h"
+#include "AlsGroundHeightCacheComponent.generated.h"
+
+class UPhysicalMaterial;
+
+USTRUCT(BlueprintType)
+struct ALS_API FAlsGroundHeightSample
+{
+	GENERATED_BODY()
+
+public:
+	// Coordinates of the world grid cell that the sample belongs to.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS")
+	FIntPoint Cell{TNumericLimits<int32>::Max(), TNumericLimits<int32>::Max()};
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS")
+	FVector ImpactPoint{ForceInit};
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS")
+	FVector ImpactNormal{FVector::ZAxisVector};
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS")
+	TWeakObjectPtr<UPrimitiveComponent> Component;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS")
+	TWeakObjectPtr<UPhysicalMaterial> PhysicalMaterial;
+
+	// Height of the owning actor's bottom at the time the sample was traced.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS", Meta = (ForceUnits = "cm"))
+	double TraceOriginZ{0.0};
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS")
+	uint8 bValid : 1 {false};
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS")
+	uint8 bBlockingHit : 1 {false};
+};
+
+USTRUCT(BlueprintType)
+struct ALS_API FAlsGroundHeightCacheDebugState
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS")
+	int32 SampleTracesCount{0};
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS")
+	int32 ValidationsCount{0};
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS", Meta = (ForceUnits = "cm"))
+	float AverageHeightError{0.0f};
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS", Meta = (ForceUnits = "cm"))
+	float MaxHeightError{0.0f};
+};
+
+// Keeps a small grid of ground heights and normals sampled around the owning actor, so that foot placement can
+// read the ground by interpolating the samples instead of tracing every frame. The grid is aligned to the world, so
+// samples stay valid while the actor moves, and only the cells that enter the grid are resampled, within a per-frame
+// sample budget. Samples of movable geometry are resampled when that geometry moves.
+UCLASS(ClassGroup = "ALS", Meta = (BlueprintSpawnableComponent))
+class ALS_API UAlsGroundHeightCacheComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings")
+	TEnumAsByte<ECollisionChannel> TraceChannel{ECC_Visibility};
+
+	// Number of grid cells along each side of the grid.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings", Meta = (ClampMin = 2, ClampMax = 32))
+	int32 GridSize{8};
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings", Meta = (ClampMin = 1, ForceUnits = "cm"))
+	float CellSize{15.0f};
+
+	// Samples are traced from this height above the bottom of the owning actor.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings", Meta = (ClampMin = 0, ForceUnits = "cm"))
+	float TraceDistanceUpward{50.0f};
+
+	// Samples are traced to this depth below the bottom of the owning actor.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings", Meta = (ClampMin = 0, ForceUnits = "cm"))
+	float TraceDistanceDownward{80.0f};
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings", Meta = (ClampMin = 1))
+	int32 MaxSampleTracesPerFrame{8};
+
+	// Ground queries fail if the heights of the samples around the query location differ by more than this value,
+	// because interpolation is not reliable on steps and ledges. In this case, the caller is expected to trace.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings", Meta = (ClampMin = 0, ForceUnits = "cm"))
+	float MaxInterpolatedHeightDifference{5.0f};
+
+protected:
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
+	TArray<FAlsGroundHeightSample> Samples;
+
+	// Grid cell coordinates of the grid center.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
+	FIntPoint CenterCell{ForceInit};
+
+	// Movable components hit by the samples, along with their transforms at the time they were sampled.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
+	TMap<TWeakObjectPtr<UPrimitiveComponent>, FTransform> SampledMovableComponents;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
+	FAlsGroundHeightCacheDebugState DebugState;
+
+private:
+	// Offsets of the grid cells relative to the grid center, sorted by distance to it, so that cells near the center are sampled first.
+	TArray<FIntPoint> CellOffsetsByDistance;
+
+	// Samples are written on the game thread and read from animation worker threads.
+	mutable FRWLock SamplesLock;
+
+public:
+	UAlsGroundHeightCacheComponent();
+
+	virtual void OnRegister() override;
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	// Thread safe. Bilinearly interpolates the ground height and normal at the given location, and fills in the impact point, impact normal,
+	// component and physical material of the hit. Returns false if the location is outside the grid, the samples around it are not ready
+	// yet, or the ground under it is not smooth enough to be interpolated.
+	bool TryGetGround(const FVector& Location, FHitResult& Hit) const;
+
+private:
+	void ResetSamples();
+
+	int32 GetSampleIndex(const FIntPoint& Cell) const;
+
+	FVector GetTraceOrigin() const;
+
+	void InvalidateMovedSamples();
+
+	void RefreshSamples(const FVector& TraceOrigin);
+
+	bool TryGetGroundUnsafe(const FVector& Location, FHitResult& Hit) const;
+
+#if ENABLE_DRAW_DEBUG
+	void ValidateSamples(const FVector& TraceOrigin);
+
+	void DrawDebug(const FVector& TraceOrigin) const;
+#endif
+};
@@ -14,6 +14,11 @@ protected:
 	UPROPERTY(VisibleAnywhere, Category = "State", Transient)
 	TWeakObjectPtr<UAlsAnimationInstance> Parent;
 
+	// Resolved from the weak parent pointer once per update on the game thread, so that accessors and forwarders,
+	// which can be called many times per update from worker threads, don't have to resolve the weak pointer every time.
+	// The parent is the main animation instance of the same skeletal mesh, so it always outlives this instance.
+	UAlsAnimationInstance* ParentUnsafe{nullptr};
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
 	TObjectPtr<AAlsCharacter> Character;
 
@@ -24,6 +29,8 @@ public:
 
 	virtual void NativeBeginPlay() override;
 
+	virtual void NativeUpdateAnimation(float DeltaTime) override;
+
 protected:
 	virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override;
 
@@ -96,10 +103,10 @@ protected:
 
 inline UAlsAnimationInstance* UAlsLinkedAnimationInstance::GetParentUnsafe() const
 {
-	return Parent.Get();
+	return ParentUnsafe;
 }
 
 inline UAlsAnimationInstance* UAlsLinkedAnimationInstance::GetParent() const
 {
-	return Parent.Get();
+	return ParentUnsafe;
 }
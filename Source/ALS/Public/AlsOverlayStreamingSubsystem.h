@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "AlsOverlayStreamingSubsystem.generated.h"
+
+class UAnimInstance;
+struct FStreamableHandle;
+
+struct ALS_API FAlsStreamedOverlayLayerClass
+{
+	// Number of characters that want this layer class to stay resident.
+	int32 ReferencesCount{0};
+
+	TSharedPtr<FStreamableHandle> StreamingHandle;
+
+	// Estimated memory used by the animations referenced by the layer class. Valid only after loading is complete.
+	int64 AnimationsMemory{0};
+};
+
+// Streams overlay layer classes asynchronously and keeps them resident while at least one character references them, so
+// that switching overlay modes never blocks the game thread on a synchronous load. When the last reference is released,
+// the streaming handle is dropped and the layer class, along with its animations, can be garbage collected.
+UCLASS()
+class ALS_API UAlsOverlayStreamingSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+private:
+	TMap<FSoftObjectPath, FAlsStreamedOverlayLayerClass> LayerClasses;
+
+	int64 ResidentAnimationsMemory{0};
+
+public:
+	virtual void Deinitialize() override;
+
+protected:
+	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+
+public:
+	void AddLayerClassReference(const TSoftClassPtr<UAnimInstance>& LayerClass);
+
+	void RemoveLayerClassReference(const TSoftClassPtr<UAnimInstance>& LayerClass);
+
+	int64 GetLayerClassAnimationsMemory(const TSoftClassPtr<UAnimInstance>& LayerClass) const;
+
+	int64 GetResidentAnimationsMemory() const;
+
+private:
+	void OnLayerClassLoaded(FSoftObjectPath LayerClassPath);
+};
+
+inline int64 UAlsOverlayStreamingSubsystem::GetResidentAnimationsMemory() const
+{
+	return ResidentAnimationsMemory;
+}
@@ -18,9 +18,25 @@ public:
 	TArray<FGameplayTag> Tags;
 #endif
 
+protected:
+	// Tag to pose index lookup, built from the tags on the first update, since they can't change at runtime.
+	TMap<FGameplayTag, int32> TagIndices;
+
+	FGameplayTag LastActiveTag;
+
+	int32 LastActiveChildIndex{0};
+
+	bool bTagIndicesValid{false};
+
+public:
+	virtual void Initialize_AnyThread(const FAnimationInitializeContext& Context) override;
+
 protected:
 	virtual int32 GetActiveChildIndex() override;
 
+private:
+	void RefreshTagIndices();
+
 public:
 	const FGameplayTag& GetActiveTag() const;
 
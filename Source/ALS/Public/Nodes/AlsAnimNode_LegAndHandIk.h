@@ -0,0 +1,197 @@
+#pragma once
+
+#include "BoneControllers/AnimNode_SkeletalControlBase.h"
+#include "State/AlsControlRigInput.h"
+#include "State/AlsFootGroundCache.h"
+#include "Utility/AlsConstants.h"
+#include "Utility/AlsMath.h"
+#include "AlsAnimNode_LegAndHandIk.generated.h"
+
+struct FAlsLegIkState
+{
+	bool bInitialized{false};
+
+	FAlsSpringFloatState OffsetSpringState;
+
+	float OffsetLocationZ{0.0f};
+
+	FVector OffsetNormal{FVector::ZAxisVector};
+
+	float LegLength{0.0f};
+};
+
+// Native approximation of the foot offset, foot lock and hand IK retargeting parts of the ALS control rig, without the overhead
+// of the control rig virtual machine and hierarchy synchronization. The foot offset and hand IK retargeting math is shared
+// with the corresponding rig units, but the pelvis offset, the leg IK solver and the order of operations are implemented
+// separately from the control rig graph, so the results are not guaranteed to match it exactly. Use the minimum LOD level
+// to run this node only on distant characters, while the control rig node, with its LOD threshold set one level lower,
+// keeps handling close characters.
+USTRUCT(BlueprintInternalUseOnly)
+struct ALS_API FAlsAnimNode_LegAndHandIk : public FAnimNode_SkeletalControlBase
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Settings", Meta = (PinShownByDefault))
+	FAlsControlRigInput Input;
+
+	// The node is evaluated only if the current mesh LOD level is greater than or equal to this value. Together with
+	// the LOD threshold, this allows to run the node in a range of LODs. This is based on the mesh LOD level alone,
+	// which is driven by the screen size, and not on the significance of the character.
+	UPROPERTY(EditAnywhere, Category = "Performance", Meta = (ClampMin = -1))
+	int32 MinLodLevel{INDEX_NONE};
+
+	// When the node becomes active again after being skipped, for example when the LOD level crosses the
+	// minimum LOD level, its output is blended in over this duration, so that the character doesn't snap.
+	UPROPERTY(EditAnywhere, Category = "Performance", Meta = (ClampMin = 0, ForceUnits = "s"))
+	float BlendInDuration{0.2f};
+
+	UPROPERTY(EditAnywhere, Category = "Bones")
+	FBoneReference PelvisBone{UAlsConstants::PelvisBoneName()};
+
+	UPROPERTY(EditAnywhere, Category = "Bones")
+	FBoneReference LeftThighBone{TEXT("thigh_l")};
+
+	UPROPERTY(EditAnywhere, Category = "Bones")
+	FBoneReference LeftCalfBone{TEXT("calf_l")};
+
+	UPROPERTY(EditAnywhere, Category = "Bones")
+	FBoneReference LeftFootBone{UAlsConstants::FootLeftBoneName()};
+
+	UPROPERTY(EditAnywhere, Category = "Bones")
+	FBoneReference RightThighBone{TEXT("thigh_r")};
+
+	UPROPERTY(EditAnywhere, Category = "Bones")
+	FBoneReference RightCalfBone{TEXT("calf_r")};
+
+	UPROPERTY(EditAnywhere, Category = "Bones")
+	FBoneReference RightFootBone{UAlsConstants::FootRightBoneName()};
+
+	UPROPERTY(EditAnywhere, Category = "Bones")
+	FBoneReference LeftHandBone{TEXT("hand_l")};
+
+	UPROPERTY(EditAnywhere, Category = "Bones")
+	FBoneReference LeftHandIkBone{TEXT("ik_hand_l")};
+
+	UPROPERTY(EditAnywhere, Category = "Bones")
+	FBoneReference RightHandBone{TEXT("hand_r")};
+
+	UPROPERTY(EditAnywhere, Category = "Bones")
+	FBoneReference RightHandIkBone{TEXT("ik_hand_r")};
+
+	UPROPERTY(EditAnywhere, Category = "Bones")
+	TArray<FBoneReference> HandIkBonesToMove{FBoneReference{TEXT("ik_hand_gun")}};
+
+	UPROPERTY(EditAnywhere, Category = "Foot Offset Trace")
+	TEnumAsByte<ECollisionChannel> TraceChannel{ECC_Visibility};
+
+	UPROPERTY(EditAnywhere, Category = "Foot Offset Trace", Meta = (ClampMin = 0, ForceUnits = "cm"))
+	float TraceDistanceUpward{50.0f};
+
+	UPROPERTY(EditAnywhere, Category = "Foot Offset Trace", Meta = (ClampMin = 0, ForceUnits = "cm"))
+	float TraceDistanceDownward{80.0f};
+
+	UPROPERTY(EditAnywhere, Category = "Foot Offset Trace", Meta = (ClampMin = 0, ClampMax = 90, ForceUnits = "deg"))
+	float WalkableFloorAngle{45.0f};
+
+	UPROPERTY(EditAnywhere, Category = "Foot Offset Trace", Meta = (ClampMin = 0, ForceUnits = "cm"))
+	float FootHeight{13.5f};
+
+	UPROPERTY(EditAnywhere, Category = "Foot Offset Trace")
+	uint8 bUseGroundHeightCache : 1 {false};
+
+	UPROPERTY(EditAnywhere, Category = "Foot Offset Trace")
+	uint8 bAsyncTrace : 1 {false};
+
+	UPROPERTY(EditAnywhere, Category = "Foot Offset Trace", Meta = (ClampMin = 0, ForceUnits = "cm"))
+	float MaxAsyncTraceExtrapolationDistance{30.0f};
+
+	// This limits how high the foot offset can raise the foot relative to the pelvis.
+	UPROPERTY(EditAnywhere, Category = "Foot Offset Location", Meta = (ClampMin = 0, ForceUnits = "cm"))
+	float MinPelvisToFootDistanceZ{50.0f};
+
+	// Used to prevent the leg from being fully straightened.
+	UPROPERTY(EditAnywhere, Category = "Foot Offset Location", Meta = (ClampMin = 0.01, ForceUnits = "x"))
+	float MaxLegStretchRatio{0.99f};
+
+	UPROPERTY(EditAnywhere, Category = "Foot Offset Location", Meta = (ClampMin = 0, ForceUnits = "hz"))
+	float OffsetInterpolationFrequency{0.4f};
+
+	UPROPERTY(EditAnywhere, Category = "Foot Offset Location", Meta = (ClampMin = 0))
+	float OffsetInterpolationDampingRatio{4.0f};
+
+	UPROPERTY(EditAnywhere, Category = "Foot Offset Location", Meta = (ClampMin = 0, ClampMax = 1))
+	float OffsetInterpolationTargetVelocityAmount{1.0f};
+
+	UPROPERTY(EditAnywhere, Category = "Foot Offset Rotation")
+	FQuat LimitOffset{FRotator{5.0f, 5.0f, 0.0f}};
+
+	UPROPERTY(EditAnywhere, Category = "Foot Offset Rotation", DisplayName = "Swing 1 Limit Angle",
+		Meta = (ClampMin = 0, ClampMax = 180, ForceUnits = "deg"))
+	float Swing1LimitAngle{25.0f};
+
+	UPROPERTY(EditAnywhere, Category = "Foot Offset Rotation", DisplayName = "Swing 2 Limit Angle",
+		Meta = (ClampMin = 0, ClampMax = 180, ForceUnits = "deg"))
+	float Swing2LimitAngle{5.0f};
+
+	UPROPERTY(EditAnywhere, Category = "Foot Offset Rotation", Meta = (ClampMin = 0, ClampMax = 180, ForceUnits = "deg"))
+	float TwistLimitAngle{0.0f};
+
+	// The higher the value, the faster the interpolation. A zero value results in instant interpolation.
+	UPROPERTY(EditAnywhere, Category = "Foot Offset Rotation", Meta = (ClampMin = 0))
+	float RotationOffsetInterpolationSpeed{20.0f};
+
+	// Which hand to favor. 0.5 is equal weight for both, 1 - right hand, 0 - left hand.
+	UPROPERTY(EditAnywhere, Category = "Hand Ik Retargeting", Meta = (ClampMin = 0, ClampMax = 1))
+	float RetargetingWeight{0.5f};
+
+	UPROPERTY(EditAnywhere, Category = "Hand Ik Retargeting", Meta = (ClampMin = 0, ClampMax = 1, PinHiddenByDefault))
+	float RetargetingAmount{1.0f};
+
+	// If disabled, the children of the moved hand IK bones keep their component space transforms.
+	UPROPERTY(EditAnywhere, Category = "Hand Ik Retargeting")
+	uint8 bPropagateToChildren : 1 {false};
+
+protected:
+	FAlsLegIkState LeftLegState;
+
+	FAlsLegIkState RightLegState;
+
+	bool bPelvisInitialized{false};
+
+	FAlsSpringFloatState PelvisOffsetSpringState;
+
+	float PelvisOffset{0.0f};
+
+	float DeltaTime{0.0f};
+
+	float BlendInAmount{0.0f};
+
+	FGraphTraversalCounter UpdateCounter;
+
+	TArray<FCompactPoseBoneIndex> HandIkBonesToMoveChildren;
+
+public:
+	virtual void Initialize_AnyThread(const FAnimationInitializeContext& Context) override;
+
+	virtual void UpdateInternal(const FAnimationUpdateContext& Context) override;
+
+	virtual void EvaluateSkeletalControl_AnyThread(FComponentSpacePoseContext& Output, TArray<FBoneTransform>& OutBoneTransforms) override;
+
+	virtual bool IsValidToEvaluate(const USkeleton* Skeleton, const FBoneContainer& RequiredBones) override;
+
+	virtual void GatherDebugData(FNodeDebugData& DebugData) override;
+
+protected:
+	virtual void InitializeBoneReferences(const FBoneContainer& RequiredBones) override;
+
+private:
+	void RefreshHandIkRetargeting(FComponentSpacePoseContext& Output) const;
+
+	float CalculateFootOffsetLocationZ(const FComponentSpacePoseContext& Output, const FVector& FootTargetLocation,
+	                                   EAlsFootBone FootBone, FVector& FootOffsetNormal) const;
+
+	void RefreshLeg(FComponentSpacePoseContext& Output, FAlsLegIkState& LegState, const FBoneReference& ThighBone,
+	                const FBoneReference& CalfBone, const FBoneReference& FootBone, const FVector& FootTargetLocation,
+	                const FQuat& FootTargetRotation, float FootOffsetLocationZ, const FVector& FootOffsetNormal, float IkAmount);
+};
@@ -76,4 +76,11 @@ public:
 	RIGVM_METHOD()
 	// ReSharper disable once CppFunctionIsNotImplemented
 	virtual void Execute() override;
+
+	// The following functions are also used by the native leg and hand IK anim node.
+
+	static float CalculateTargetOffsetLocationZ(float FootTargetLocationZ, float FootOffsetLocationZ, float PelvisLocationZ,
+	                                            float PelvisOffset, float MinPelvisToFootDistanceZ);
+
+	static FVector LimitLegStretch(const FVector& FootLocation, const FVector& ThighLocation, float MaxLegLength);
 };
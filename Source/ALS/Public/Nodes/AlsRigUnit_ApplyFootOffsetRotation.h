@@ -52,4 +52,8 @@ public:
 	RIGVM_METHOD()
 	// ReSharper disable once CppFunctionIsNotImplemented
 	virtual void Execute() override;
+
+	// Also used by the native leg and hand IK anim node.
+	static FQuat CalculateFootRotation(const FQuat& CalfRotation, const FQuat& FootTargetRotation, const FVector& OffsetNormal,
+	                                   const FQuat& LimitOffset, float Swing1LimitAngle, float Swing2LimitAngle, float TwistLimitAngle);
 };
@@ -27,6 +27,20 @@ public:
 	UPROPERTY(Transient)
 	FCachedRigElement CachedDescendantItem;
 
+	// Hierarchy indices of the chain elements, from the ancestor to the descendant. Rebuilt
+	// only when the chain items or the hierarchy topology change, not on every execution.
+	UPROPERTY(Transient)
+	TArray<int32> CachedChainIndices;
+
+	UPROPERTY(Transient)
+	FRigElementKey CachedChainAncestorItem;
+
+	UPROPERTY(Transient)
+	FRigElementKey CachedChainDescendantItem;
+
+	UPROPERTY(Transient)
+	int32 CachedChainTopologyVersion{INDEX_NONE};
+
 public:
 	RIGVM_METHOD()
 	virtual void Execute() override;
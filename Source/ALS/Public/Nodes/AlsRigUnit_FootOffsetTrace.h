@@ -1,8 +1,11 @@
 #pragma once
 
+#include "State/AlsFootGroundCache.h"
 #include "Units/RigUnit.h"
 #include "AlsRigUnit_FootOffsetTrace.generated.h"
 
+struct FHitResult;
+
 USTRUCT(DisplayName = "Foot Offset Trace", Meta = (Category = "ALS", NodeColor = "0.2 0.4 1.0"))
 struct ALS_API FAlsRigUnit_FootOffsetTrace : public FRigUnit
 {
@@ -27,6 +30,32 @@ public:
 	UPROPERTY(Meta = (Input, ClampMin = 0, ForceUnits = "cm"))
 	float FootHeight{13.5f};
 
+	// Foot to publish the trace hit for in the foot ground cache of the ALS animation instance. Also
+	// identifies the foot for asynchronous traces, so each foot must use a different value.
+	UPROPERTY(Meta = (Input))
+	EAlsFootBone FootBone{EAlsFootBone::Left};
+
+	// If enabled, the trace hit is published to the foot ground cache of the ALS animation
+	// instance, so that footstep effects can reuse it instead of tracing under the foot again.
+	UPROPERTY(Meta = (Input))
+	bool bPublishToFootGroundCache{false};
+
+	// If enabled and the owning actor has a ground height cache component, the ground is read from it instead of
+	// tracing. If the cache can't provide the ground under the foot, the trace is performed as usual.
+	UPROPERTY(Meta = (Input))
+	bool bUseGroundHeightCache{false};
+
+	// If enabled, the trace is performed asynchronously and its result is used on the next frame, extrapolated along
+	// the hit surface to the current foot location. This doesn't block the animation evaluation on scene queries, but is
+	// slightly less precise, so keep it disabled where quality matters the most, for example, in cinematics.
+	UPROPERTY(Meta = (Input))
+	bool bAsyncTrace{false};
+
+	// If the foot has moved farther than this distance since the previous asynchronous
+	// trace, its result is discarded and a synchronous trace is performed instead.
+	UPROPERTY(Meta = (Input, ClampMin = 0, ForceUnits = "cm"))
+	float MaxAsyncTraceExtrapolationDistance{30.0f};
+
 	UPROPERTY(Meta = (Input))
 	bool bEnabled{true};
 
@@ -42,4 +71,14 @@ public:
 public:
 	RIGVM_METHOD()
 	virtual void Execute() override;
+
+	// The following functions are also used by the native leg and hand IK anim node.
+
+	static void TraceGround(const UWorld* World, const USceneComponent* OwningComponent, const FTransform& ComponentTransform,
+	                        const FVector& FootTargetLocation, ECollisionChannel TraceChannel, float TraceDistanceUpward,
+	                        float TraceDistanceDownward, EAlsFootBone FootBone, bool bUseGroundHeightCache, bool bAsyncTrace,
+	                        float MaxAsyncTraceExtrapolationDistance, bool bReturnPhysicalMaterial, FHitResult& Hit);
+
+	static void CalculateFootOffset(const FHitResult& Hit, const FTransform& ComponentTransform, float WalkableFloorAngle,
+	                                float FootHeight, float& OffsetLocationZ, FVector& OffsetNormal);
 };
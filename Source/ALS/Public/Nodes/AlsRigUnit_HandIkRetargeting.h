@@ -52,4 +52,9 @@ public:
 public:
 	RIGVM_METHOD()
 	virtual void Execute() override;
+
+	// Also used by the native leg and hand IK anim node.
+	static FVector CalculateRetargetingOffset(const FVector& LeftHandLocation, const FVector& LeftHandIkLocation,
+	                                          const FVector& RightHandLocation, const FVector& RightHandIkLocation,
+	                                          float RetargetingWeight, float Weight);
 };
@@ -3,20 +3,17 @@
 #include "Animation/AnimNotifies/AnimNotify.h"
 #include "Engine/DataAsset.h"
 #include "Engine/EngineTypes.h"
+#include "State/AlsFootGroundCache.h"
 #include "AlsAnimNotify_FootstepEffects.generated.h"
 
 enum EPhysicalSurface : int;
 struct FHitResult;
+struct FStreamableHandle;
 class USoundBase;
 class UMaterialInterface;
 class UNiagaraSystem;
-
-UENUM(BlueprintType)
-enum class EAlsFootBone : uint8
-{
-	Left,
-	Right,
-};
+class UNiagaraDataChannelAsset;
+class UAlsFootstepEffectsSubsystem;
 
 UENUM(BlueprintType)
 enum class EAlsFootstepSoundType : uint8
@@ -44,7 +41,10 @@ UENUM(BlueprintType)
 enum class EAlsFootstepParticleEffectSpawnMode : uint8
 {
 	SpawnAtTraceHitLocation,
-	SpawnAttachedToFootBone
+	SpawnAttachedToFootBone,
+	// Writes the footstep into a Niagara data channel instead of spawning a separate
+	// particle system, so that a single system can render footsteps of all characters.
+	WriteToDataChannel
 };
 
 USTRUCT(BlueprintType)
@@ -81,6 +81,15 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0, ForceUnits = "s"))
 	float FadeOutDuration{2.0f};
 
+	// Maximum number of simultaneously visible decals of this surface type per world. When exceeded, the oldest
+	// of them is reused. If zero is specified, the number is limited only by the footstep decal pool capacity.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0))
+	int32 MaxCount{0};
+
+	// Decals are not spawned farther than this distance from all local player cameras. If zero is specified, decals are always spawned.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0, ForceUnits = "cm"))
+	float MaxSpawnDistance{0.0f};
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
 	FVector3f LocationOffset{0.0f, -10.0f, -1.75f};
 
@@ -114,6 +123,11 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
 	EAlsFootstepParticleEffectSpawnMode SpawnMode{EAlsFootstepParticleEffectSpawnMode::SpawnAtTraceHitLocation};
 
+	// Used only in the write to data channel spawn mode. The data channel is expected to have the
+	// Position (position), Normal (vector), SurfaceType (int) and Intensity (float) variables.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
+	TSoftObjectPtr<UNiagaraDataChannelAsset> DataChannel;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
 	FVector3f LocationOffset{ForceInit};
 
@@ -156,6 +170,74 @@ public:
 #endif
 };
 
+USTRUCT(BlueprintType)
+struct ALS_API FAlsFootstepSignificanceSettings
+{
+	GENERATED_BODY()
+
+public:
+	// Footstep sounds are not played farther than this distance from all local audio listeners. If zero is specified, sounds are always played.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0, ForceUnits = "cm"))
+	float MaxSoundDistance{4000.0f};
+
+	// Footstep decals are not spawned farther than this distance from all local player cameras. If zero is specified, decals are always spawned.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0, ForceUnits = "cm"))
+	float MaxDecalDistance{3000.0f};
+
+	// Footstep particle systems are not spawned farther than this distance from all local player
+	// cameras. If zero is specified, particle systems are always spawned.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0, ForceUnits = "cm"))
+	float MaxParticleSystemDistance{3000.0f};
+
+	// Decals and particle systems are not spawned if the character's bounding sphere occupies less than this
+	// fraction of the screen in all local player views. If zero is specified, the screen size is not checked.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0, ClampMax = 1))
+	float MinScreenSize{0.02f};
+
+	// Footsteps of locally controlled player characters are never culled and are not limited by the per-frame budget.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
+	uint8 bAlwaysSignificantForLocalPlayer : 1 {true};
+};
+
+// Footstep effect settings of a single surface type, compiled for fast lookup, with resolved effect assets.
+USTRUCT(BlueprintType)
+struct ALS_API FAlsCompiledFootstepEffect
+{
+	GENERATED_BODY()
+
+public:
+	// Surface type of the entry in the effects map that this effect was compiled from. May differ from the
+	// surface type used to look up this effect if there are no effects for it and a fallback is used.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS", Transient)
+	TEnumAsByte<EPhysicalSurface> SurfaceType{SurfaceType_Default};
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS", Transient)
+	TObjectPtr<USoundBase> Sound;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS", Transient)
+	TObjectPtr<UMaterialInterface> DecalMaterial;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS", Transient)
+	TObjectPtr<UNiagaraSystem> ParticleSystem;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS", Transient)
+	TObjectPtr<UNiagaraDataChannelAsset> ParticleSystemDataChannel;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS", Transient)
+	uint8 bHasSound : 1 {false};
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS", Transient)
+	uint8 bHasDecal : 1 {false};
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS", Transient)
+	uint8 bHasParticleSystem : 1 {false};
+
+	// Copy of the entry in the effects map that this effect was compiled from, so that the compiled
+	// effects remain valid even if the effects map is reallocated by an edit or an undo in the editor.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS", Transient)
+	FAlsFootstepEffectSettings Settings;
+};
+
 UCLASS(Blueprintable, BlueprintType)
 class ALS_API UAlsFootstepEffectsSettings : public UDataAsset
 {
@@ -168,6 +250,16 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings", Meta = (ClampMin = 0, ForceUnits = "cm"))
 	float SurfaceTraceDistance{50.0f};
 
+	// Foot ground hits published by the foot offset trace rig unit are reused instead of tracing for
+	// the surface if they are not older than this value. If zero is specified, they are never reused.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings", Meta = (ClampMin = 0, ForceUnits = "s"))
+	float FootGroundCacheMaxAge{0.1f};
+
+	// Foot ground hits published by the foot offset trace rig unit are reused only if
+	// they are not farther than this horizontal distance from the current foot location.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings", Meta = (ClampMin = 0, ForceUnits = "cm"))
+	float FootGroundCacheMaxDistance{10.0f};
+
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings", DisplayName = "Foot Left Y Axis")
 	FVector3f FootLeftYAxis{0.0f, 0.0f, 1.0f};
 
@@ -187,15 +279,54 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Settings", AdvancedDisplay, Meta = (ClampMin = 0, ClampMax = 1))
 	float DecalSpawnAngleThresholdCos{FMath::Cos(FMath::DegreesToRadians(35.0f))};
 
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings")
+	FAlsFootstepSignificanceSettings Significance;
+
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings", Meta = (ForceInlineRow))
 	TMap<TEnumAsByte<EPhysicalSurface>, FAlsFootstepEffectSettings> Effects;
 
+	// Effects compiled from the effects map, indexed directly by surface type. Surface types that are not present in the
+	// effects map fall back to its first entry. Compiled all at once when the asynchronous loading of effect assets started
+	// by LoadEffectAssetsAsync() completes, and shared by all footstep notifies that use these settings. Empty until then.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient, EditFixedSize)
+	TArray<FAlsCompiledFootstepEffect> CompiledEffects;
+
+private:
+	TSharedPtr<FStreamableHandle> EffectAssetsStreamingHandle;
+
+	uint8 bEffectAssetsLoadingRequested : 1 {false};
+
 public:
+	virtual void PostLoad() override;
+
 #if WITH_EDITOR
 	virtual void PostEditChangeProperty(FPropertyChangedEvent& ChangedEvent) override;
+
+	virtual void PostEditUndo() override;
 #endif
+
+	bool IsEffectAssetsLoadingRequested() const;
+
+	UFUNCTION(BlueprintCallable, Category = "ALS|Footstep Effects Settings")
+	void LoadEffectAssetsAsync();
+
+	// Returns null if the effects are not compiled yet.
+	const FAlsCompiledFootstepEffect* FindCompiledEffect(EPhysicalSurface SurfaceType) const;
+
+private:
+	void CompileEffects();
 };
 
+inline bool UAlsFootstepEffectsSettings::IsEffectAssetsLoadingRequested() const
+{
+	return bEffectAssetsLoadingRequested;
+}
+
+inline const FAlsCompiledFootstepEffect* UAlsFootstepEffectsSettings::FindCompiledEffect(const EPhysicalSurface SurfaceType) const
+{
+	return CompiledEffects.IsValidIndex(SurfaceType) ? &CompiledEffects[SurfaceType] : nullptr;
+}
+
 UCLASS(DisplayName = "Als Footstep Effects Animation Notify",
 	AutoExpandCategories = ("Settings|Sound", "Settings|Decal", "Settings|Particle System"))
 class ALS_API UAlsAnimNotify_FootstepEffects : public UAnimNotify
@@ -233,6 +364,10 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings|Particle System")
 	uint8 bSpawnParticleSystem : 1 {true};
 
+	// Written into the Intensity variable of the Niagara data channel in the write to data channel spawn mode.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings|Particle System", Meta = (ClampMin = 0, ForceUnits = "x"))
+	float ParticleSystemIntensity{1.0f};
+
 public:
 	virtual FString GetNotifyName_Implementation() const override;
 
@@ -244,13 +379,20 @@ public:
 	                    const FAnimNotifyEventReference& NotifyEventReference) override;
 
 private:
-	void SpawnSound(USkeletalMeshComponent* Mesh, const FAlsFootstepSoundSettings& SoundSettings,
+	bool TryGetFootGroundCacheHit(const USkeletalMeshComponent* Mesh, const FVector& FootLocation, FHitResult& FootstepHit) const;
+
+	void SpawnSound(USkeletalMeshComponent* Mesh, UAlsFootstepEffectsSubsystem* EffectsSubsystem,
+	                const FAlsFootstepSoundSettings& SoundSettings, USoundBase* Sound,
 	                const FVector& FootstepLocation, const FQuat& FootstepRotation) const;
 
-	void SpawnDecal(USkeletalMeshComponent* Mesh, const FAlsFootstepDecalSettings& DecalSettings,
-	                const FVector& FootstepLocation, const FQuat& FootstepRotation,
+	void SpawnDecal(USkeletalMeshComponent* Mesh, const FAlsFootstepDecalSettings& DecalSettings, UMaterialInterface* DecalMaterial,
+	                EPhysicalSurface SurfaceType, const FVector& FootstepLocation, const FQuat& FootstepRotation,
 	                const FHitResult& FootstepHit, const FVector& FootZAxis) const;
 
 	void SpawnParticleSystem(USkeletalMeshComponent* Mesh, const FAlsFootstepParticleSystemSettings& ParticleSystemSettings,
-	                         const FVector& FootstepLocation, const FQuat& FootstepRotation) const;
+	                         const FAlsCompiledFootstepEffect& Effect, const FVector& FootstepLocation,
+	                         const FQuat& FootstepRotation) const;
+
+	void WriteParticleSystemDataChannel(USkeletalMeshComponent* Mesh, UNiagaraDataChannelAsset* DataChannel, EPhysicalSurface SurfaceType,
+	                                    const FVector& ParticleSystemLocation, const FQuat& FootstepRotation) const;
 };
@@ -6,6 +6,7 @@
 #include "AlsGeneralAnimationSettings.h"
 #include "AlsGroundedSettings.h"
 #include "AlsInAirSettings.h"
+#include "AlsOverlayLayersSettings.h"
 #include "AlsRotateInPlaceSettings.h"
 #include "AlsStandingSettings.h"
 #include "AlsTransitionsSettings.h"
@@ -53,6 +54,9 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings")
 	FAlsGeneralTurnInPlaceSettings TurnInPlace;
 
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings")
+	FAlsOverlayLayersSettings OverlayLayers;
+
 public:
 	UAlsAnimationInstanceSettings();
 
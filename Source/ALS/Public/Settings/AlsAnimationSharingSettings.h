@@ -0,0 +1,31 @@
+#pragma once
+
+#include "AlsAnimationSharingSettings.generated.h"
+
+USTRUCT(BlueprintType)
+struct ALS_API FAlsAnimationSharingSettings
+{
+	GENERATED_BODY()
+
+	// If checked, a distant character can copy the pose of another distant character in the same
+	// locomotion state instead of evaluating its own animation blueprint. Characters are grouped by
+	// skeletal mesh, animation blueprint class, locomotion state, speed and movement direction.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
+	uint8 bEnabled : 1 {false};
+
+	// The character can share animations only if it is farther than this distance from all local player cameras.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0, EditCondition = "bEnabled", ForceUnits = "cm"))
+	float MinViewDistance{3000.0f};
+
+	// Prevents the character from constantly joining and leaving a group when it is near the minimum view distance.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0, EditCondition = "bEnabled", ForceUnits = "cm"))
+	float ViewDistanceHysteresis{300.0f};
+
+	// Characters whose speeds fall into the same bucket of this size are considered to move at the same speed.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 1, EditCondition = "bEnabled", ForceUnits = "cm/s"))
+	float SpeedBucketSize{100.0f};
+
+	// Number of sectors into which the velocity direction relative to the character rotation is divided.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 1, EditCondition = "bEnabled"))
+	int32 DirectionBucketsCount{8};
+};
@@ -1,5 +1,6 @@
 ﻿#pragma once
 
+#include "AlsAnimationSharingSettings.h"
 #include "AlsInAirRotationMode.h"
 #include "AlsMantlingSettings.h"
 #include "AlsRagdollingSettings.h"
@@ -58,6 +59,9 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings")
 	FAlsRollingSettings Rolling;
 
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings")
+	FAlsAnimationSharingSettings AnimationSharing;
+
 public:
 	UAlsCharacterSettings();
 
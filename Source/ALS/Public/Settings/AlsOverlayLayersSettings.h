@@ -0,0 +1,34 @@
+#pragma once
+
+#include "GameplayTagContainer.h"
+#include "AlsOverlayLayersSettings.generated.h"
+
+class UAnimInstance;
+
+USTRUCT(BlueprintType)
+struct ALS_API FAlsOverlayLayersSettings
+{
+	GENERATED_BODY()
+
+	// Linked animation layer classes to link when the overlay mode changes. Overlay modes that share a layer class
+	// don't relink the layers when switching between them, so prefer sharing layer classes where possible. Layer
+	// classes are streamed asynchronously, and until streaming is complete, the default layer class is used instead.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ForceInlineRow, Categories = "Als.OverlayMode"))
+	TMap<FGameplayTag, TSoftClassPtr<UAnimInstance>> LayerClasses;
+
+	// Linked animation layer class used for overlay modes that are not in the layer classes map or are still streaming. If
+	// not set, the layers are unlinked and the animation blueprint's own layer implementations are used.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
+	TSubclassOf<UAnimInstance> DefaultLayerClass;
+
+	// Number of most recently used layer classes that stay resident, so that switching back to them is instant.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 1))
+	int32 RecentLayerClassesCount{2};
+
+	// Instances of the current, recently used, prefetched and default layer classes are created in advance and kept in a
+	// pool, so that switching overlay modes only rebinds the layer nodes instead of creating new instances. Only this many
+	// instances, in order of the priority listed above, are kept. The memory of the animations referenced by the layer
+	// classes is shared by all characters and is managed by the overlay streaming subsystem, not by this pool.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 1))
+	int32 MaxLayerInstancesCount{4};
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "AlsFootGroundCache.generated.h"
+
+class UPhysicalMaterial;
+class UPrimitiveComponent;
+
+UENUM(BlueprintType)
+enum class EAlsFootBone : uint8
+{
+	Left,
+	Right,
+};
+
+USTRUCT(BlueprintType)
+struct ALS_API FAlsFootGroundHit
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS")
+	uint8 bValid : 1 {false};
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS")
+	FVector TraceStart{ForceInit};
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS")
+	FVector TraceEnd{ForceInit};
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS")
+	FVector ImpactPoint{ForceInit};
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS")
+	FVector ImpactNormal{FVector::ZAxisVector};
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS")
+	TWeakObjectPtr<UPrimitiveComponent> Component;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS")
+	TWeakObjectPtr<UPhysicalMaterial> PhysicalMaterial;
+
+	// World time at which the trace was performed.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS", Meta = (ForceUnits = "s"))
+	double Time{0.0};
+};
+
+// Latest ground hit under each foot, published by the foot offset trace rig unit during animation
+// evaluation so that the footstep effects notify can reuse it instead of tracing again.
+USTRUCT(BlueprintType)
+struct ALS_API FAlsFootGroundCache
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS")
+	FAlsFootGroundHit Left;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ALS")
+	FAlsFootGroundHit Right;
+};
@@ -1,5 +1,6 @@
 #include "AlsCameraComponent.h"
 
+#include "AlsCameraDormancySubsystem.h"
 #include "AlsCameraSettings.h"
 #include "DrawDebugHelpers.h"
 #include "Animation/AnimInstance.h"
@@ -14,6 +15,17 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AlsCameraComponent)
 
+static TAutoConsoleVariable<int32> CVarCameraTraceMode(
+	TEXT("ALS.Camera.TraceMode"),
+	0,
+	TEXT("Camera collision trace mode.\n")
+	TEXT("0: Synchronous sweep every frame\n")
+	TEXT("1: Asynchronous sweep, the result is consumed in the next frame"));
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Camera Trace Queries"), STAT_AlsCameraTraceQueries, STATGROUP_Als)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Camera Blocked Geometry Cache Hits"), STAT_AlsCameraBlockedGeometryCacheHits, STATGROUP_Als)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Camera Blocked Geometry Cache Misses"), STAT_AlsCameraBlockedGeometryCacheMisses, STATGROUP_Als)
+
 UAlsCameraComponent::UAlsCameraComponent()
 {
 	PrimaryComponentTick.bStartWithTickEnabled = false;
@@ -30,6 +42,15 @@ void UAlsCameraComponent::PostLoad()
 	// This is required for the camera to work properly, as its mesh is never rendered.
 	// We change the tick option here to override the value that comes from the config file.
 	VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+
+	if (bEvaluateCurvesOnly)
+	{
+		// Nothing depends on the camera mesh bone transforms in this mode, so skip the work that is normally done after them.
+
+		bComponentUseFixedSkelBounds = true;
+		bUpdateOverlapsOnAnimationFinalize = false;
+		KinematicBonesUpdateToPhysics = EKinematicBonesUpdateToPhysics::SkipAllBones;
+	}
 }
 
 void UAlsCameraComponent::OnRegister()
@@ -56,6 +77,11 @@ void UAlsCameraComponent::Activate(const bool bReset)
 	}
 
 	Super::Activate(bReset);
+
+	if (bDormant)
+	{
+		SetComponentTickEnabled(false);
+	}
 }
 
 void UAlsCameraComponent::InitAnim(const bool bForceReinitialize)
@@ -63,6 +89,28 @@ void UAlsCameraComponent::InitAnim(const bool bForceReinitialize)
 	Super::InitAnim(bForceReinitialize);
 
 	AnimationInstance = GetAnimInstance();
+
+	if (bEvaluateCurvesOnly)
+	{
+		ExcludeNonRootBonesFromEvaluation();
+	}
+}
+
+bool UAlsCameraComponent::ShouldCreateRenderState() const
+{
+	// The camera mesh is never rendered in game, so in the curves only mode its render state is needed only for the editor preview.
+
+	if (bEvaluateCurvesOnly)
+	{
+		const auto* World{GetWorld()};
+
+		if (IsValid(World) && World->IsGameWorld())
+		{
+			return false;
+		}
+	}
+
+	return Super::ShouldCreateRenderState();
 }
 
 void UAlsCameraComponent::BeginPlay()
@@ -72,6 +120,23 @@ void UAlsCameraComponent::BeginPlay()
 	ALS_ENSURE(IsValid(Character));
 
 	Super::BeginPlay();
+
+	auto* DormancySubsystem{GetWorld()->GetSubsystem<UAlsCameraDormancySubsystem>()};
+	if (IsValid(DormancySubsystem))
+	{
+		DormancySubsystem->RegisterCamera(this);
+	}
+}
+
+void UAlsCameraComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	auto* DormancySubsystem{GetWorld()->GetSubsystem<UAlsCameraDormancySubsystem>()};
+	if (IsValid(DormancySubsystem))
+	{
+		DormancySubsystem->UnregisterCamera(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void UAlsCameraComponent::TickComponent(float DeltaTime, const ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
@@ -105,6 +170,37 @@ void UAlsCameraComponent::CompleteParallelAnimationEvaluation(const bool bDoPost
 	TickCamera(GetAnimInstance()->GetDeltaSeconds());
 }
 
+void UAlsCameraComponent::SetDormant(const bool bNewDormant)
+{
+	if (bDormant == bNewDormant)
+	{
+		return;
+	}
+
+	bDormant = bNewDormant;
+
+	if (bDormant)
+	{
+		SetComponentTickEnabled(false);
+		return;
+	}
+
+	if (!IsActive())
+	{
+		return;
+	}
+
+	SetComponentTickEnabled(true);
+
+	// The animation curves may be out of date since the camera went dormant, so refresh them on
+	// the game thread and re-seed the camera from the current character state without lag.
+
+	TickAnimation(0.0f, false);
+	RefreshBoneTransforms();
+
+	TickCamera(0.0f, false);
+}
+
 FVector UAlsCameraComponent::GetFirstPersonCameraLocation() const
 {
 	return Character->GetMesh()->GetSocketLocation(Settings->FirstPerson.CameraSocketName);
@@ -152,6 +248,27 @@ void UAlsCameraComponent::GetViewInfo(FMinimalViewInfo& ViewInfo) const
 	}
 }
 
+void UAlsCameraComponent::ExcludeNonRootBonesFromEvaluation()
+{
+	if (!IsValid(GetSkinnedAsset()))
+	{
+		return;
+	}
+
+	// Bones hidden by the PBO_Term option are removed from the required bones along with their children, so hiding
+	// the children of the root bone leaves only the root bone in the evaluated pose. Animation curves are not affected.
+
+	const auto& ReferenceSkeleton{GetSkinnedAsset()->GetRefSkeleton()};
+
+	for (auto BoneIndex{1}; BoneIndex < ReferenceSkeleton.GetNum(); BoneIndex++)
+	{
+		if (ReferenceSkeleton.GetParentIndex(BoneIndex) == 0 && !IsBoneHidden(BoneIndex))
+		{
+			HideBone(BoneIndex, PBO_Term);
+		}
+	}
+}
+
 void UAlsCameraComponent::TickCamera(const float DeltaTime, bool bAllowLag)
 {
 	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("UAlsCameraComponent::TickCamera"), STAT_UAlsCameraComponent_TickCamera, STATGROUP_Als)
@@ -391,7 +508,7 @@ float UAlsCameraComponent::CalculateFovOffset() const
 }
 
 FVector UAlsCameraComponent::CalculateCameraTrace(const FVector& CameraTargetLocation, const FVector& PivotOffset,
-                                                  const float DeltaTime, const bool bAllowLag, float& NewTraceDistanceRatio) const
+                                                  const float DeltaTime, const bool bAllowLag, float& NewTraceDistanceRatio)
 {
 #if ENABLE_DRAW_DEBUG
 	const auto bDisplayDebugCameraTraces{
@@ -418,36 +535,89 @@ FVector UAlsCameraComponent::CalculateCameraTrace(const FVector& CameraTargetLoc
 	auto TraceResult{TraceEnd};
 
 	FHitResult Hit;
-	if (GetWorld()->SweepSingleByChannel(Hit, TraceStart, TraceEnd, FQuat::Identity, Settings->ThirdPerson.TraceChannel,
-	                                     CollisionShape, {MainTraceTag, false, GetOwner()}))
+	auto bSweepSynchronously{true};
+
+	if (Settings->ThirdPerson.bEnableProbeFan)
 	{
-		if (!Hit.bStartPenetrating)
+		CameraTraceHandle.Invalidate();
+
+		// Line traces that start inside geometry don't report any hits, so if the trace start is blocked, for example when the
+		// character's back is against a wall, fall back to the sweep, which resolves the penetration before tracing again.
+
+		static const FName ProbeFanStartOverlapTag{FString::Printf(TEXT("%hs (Probe Fan Start Overlap)"), __FUNCTION__)};
+
+		INC_DWORD_STAT(STAT_AlsCameraTraceQueries)
+
+		if (!GetWorld()->OverlapBlockingTestByChannel(TraceStart, FQuat::Identity, Settings->ThirdPerson.TraceChannel,
+		                                              CollisionShape, {ProbeFanStartOverlapTag, false, GetOwner()}))
 		{
-			TraceResult = Hit.Location;
+			TraceResult = CalculateProbeFanTraceResult(TraceStart, TraceEnd, CollisionShape.GetSphereRadius(),
+			                                           bDisplayDebugCameraTraces);
+			bSweepSynchronously = false;
 		}
-		else if (TryAdjustLocationBlockedByGeometry(TraceStart, bDisplayDebugCameraTraces))
-		{
-			static const FName AdjustedTraceTag{FString::Printf(TEXT("%hs (Adjusted Trace)"), __FUNCTION__)};
+	}
+	else if (CVarCameraTraceMode.GetValueOnGameThread() <= 0)
+	{
+		CameraTraceHandle.Invalidate();
+	}
+	else
+	{
+		// Fall back to the synchronous trace if the previous frame's asynchronous trace result is missing or unreliable.
+
+		bSweepSynchronously = !TryGetAsyncCameraTraceResult(TraceStart, TraceEnd, CollisionShape.GetSphereRadius(), Hit, TraceResult);
+
+		// Request a new trace. Its result will be consumed in the next frame.
+
+		static const FName AsyncTraceTag{FString::Printf(TEXT("%hs (Async Trace)"), __FUNCTION__)};
 
-			GetWorld()->SweepSingleByChannel(Hit, TraceStart, TraceEnd, FQuat::Identity, Settings->ThirdPerson.TraceChannel,
-			                                 CollisionShape, {AdjustedTraceTag, false, GetOwner()});
-			if (Hit.IsValidBlockingHit())
+		INC_DWORD_STAT(STAT_AlsCameraTraceQueries)
+
+		CameraTraceHandle = GetWorld()->AsyncSweepByChannel(EAsyncTraceType::Single, TraceStart, TraceEnd, FQuat::Identity,
+		                                                    Settings->ThirdPerson.TraceChannel, CollisionShape,
+		                                                    {AsyncTraceTag, false, GetOwner()});
+	}
+
+	if (bSweepSynchronously)
+	{
+		INC_DWORD_STAT(STAT_AlsCameraTraceQueries)
+
+		if (GetWorld()->SweepSingleByChannel(Hit, TraceStart, TraceEnd, FQuat::Identity, Settings->ThirdPerson.TraceChannel,
+		                                     CollisionShape, {MainTraceTag, false, GetOwner()}))
+		{
+			if (!Hit.bStartPenetrating)
 			{
 				TraceResult = Hit.Location;
 			}
-		}
-		else
-		{
-			// Note that TraceStart may be changed even if TryAdjustLocationBlockedByGeometry() returned false.
-			TraceResult = TraceStart;
+			else if (TryAdjustLocationBlockedByGeometry(TraceStart, bDisplayDebugCameraTraces))
+			{
+				static const FName AdjustedTraceTag{FString::Printf(TEXT("%hs (Adjusted Trace)"), __FUNCTION__)};
+
+				INC_DWORD_STAT(STAT_AlsCameraTraceQueries)
+
+				GetWorld()->SweepSingleByChannel(Hit, TraceStart, TraceEnd, FQuat::Identity, Settings->ThirdPerson.TraceChannel,
+				                                 CollisionShape, {AdjustedTraceTag, false, GetOwner()});
+				if (Hit.IsValidBlockingHit())
+				{
+					TraceResult = Hit.Location;
+				}
+			}
+			else
+			{
+				// Note that TraceStart may be changed even if TryAdjustLocationBlockedByGeometry() returned false.
+				TraceResult = TraceStart;
+			}
 		}
 	}
 
 #if ENABLE_DRAW_DEBUG
 	if (bDisplayDebugCameraTraces)
 	{
+		// The hit result is not filled when the probe fan is used, so check whether the trace result was clamped instead.
+
 		UAlsDebugUtility::DrawSweepSphere(GetWorld(), TraceStart, TraceResult, CollisionShape.GetCapsuleRadius(),
-		                                  Hit.IsValidBlockingHit() ? FLinearColor::Red : FLinearColor::Green);
+		                                  Hit.IsValidBlockingHit() || TraceResult != TraceEnd
+			                                  ? FLinearColor::Red
+			                                  : FLinearColor::Green);
 	}
 #endif
 
@@ -478,13 +648,196 @@ FVector UAlsCameraComponent::CalculateCameraTrace(const FVector& CameraTargetLoc
 	return TraceStart + TraceVector * TraceDistanceRatio;
 }
 
-bool UAlsCameraComponent::TryAdjustLocationBlockedByGeometry(FVector& Location, const bool bDisplayDebugCameraTraces) const
+FVector UAlsCameraComponent::CalculateProbeFanTraceResult(const FVector& TraceStart, const FVector& TraceEnd,
+                                                          const float TraceRadius, const bool bDisplayDebugCameraTraces)
 {
-	// Based on ComponentEncroachesBlockingGeometry_WithAdjustment().
+	const auto& ProbeFanSettings{Settings->ThirdPerson.ProbeFan};
+	const auto MeshScale{UE_REAL_TO_FLOAT(Character->GetMesh()->GetComponentScale().Z)};
 
+	Probes.SetNum(FMath::Max(1, ProbeFanSettings.ProbeCount));
+
+	// Probes are re-traced only if their hit state changed in the previous trace or if they have moved too far since then,
+	// otherwise, their previous results are held. Additionally, one probe is refreshed every frame in a round-robin
+	// fashion so that geometry moving into a stationary probe is not missed for long.
+
+	const auto ProbeRefreshDistanceSquared{FMath::Square(ProbeFanSettings.RefreshDistance * MeshScale)};
+	ForcedRefreshProbeIndex = (ForcedRefreshProbeIndex + 1) % Probes.Num();
+
+	const auto CameraRotationQuaternion{CameraRotation.Quaternion()};
+	const auto ProbeFanRadius{ProbeFanSettings.Radius * MeshScale};
+
+	static const FName ProbeTraceTag{FString::Printf(TEXT("%hs (Probe Trace)"), __FUNCTION__)};
+	const FCollisionQueryParams QueryParameters{ProbeTraceTag, false, GetOwner()};
+
+	auto SafeDistanceRatio{1.0f};
+
+	for (auto Index{0}; Index < Probes.Num(); Index++)
+	{
+		auto& Probe{Probes[Index]};
+		auto ProbeEnd{TraceEnd};
+
+		if (Index > 0)
+		{
+			// The central probe goes straight to the camera, and the others are evenly spread around it.
+
+			const auto Angle{UE_TWO_PI * static_cast<float>(Index - 1) / static_cast<float>(Probes.Num() - 1)};
+
+			ProbeEnd += CameraRotationQuaternion.RotateVector({0.0f, FMath::Cos(Angle) * ProbeFanRadius, FMath::Sin(Angle) * ProbeFanRadius});
+		}
+
+		if (Probe.bHitChanged || Index == ForcedRefreshProbeIndex ||
+		    FVector::DistSquared(Probe.Start, TraceStart) > ProbeRefreshDistanceSquared ||
+		    FVector::DistSquared(Probe.End, ProbeEnd) > ProbeRefreshDistanceSquared)
+		{
+			INC_DWORD_STAT(STAT_AlsCameraTraceQueries)
+
+			FHitResult ProbeHit;
+			const auto bHit{
+				GetWorld()->LineTraceSingleByChannel(ProbeHit, TraceStart, ProbeEnd, Settings->ThirdPerson.TraceChannel, QueryParameters)
+			};
+
+			Probe.Start = TraceStart;
+			Probe.End = ProbeEnd;
+			Probe.HitDistanceRatio = bHit ? ProbeHit.Time : 1.0f;
+			Probe.bHitChanged = bHit != Probe.bHit;
+			Probe.bHit = bHit;
+		}
+
+		SafeDistanceRatio = FMath::Min(SafeDistanceRatio, Probe.HitDistanceRatio);
+
+#if ENABLE_DRAW_DEBUG
+		if (bDisplayDebugCameraTraces)
+		{
+			DrawDebugLine(GetWorld(), Probe.Start, FMath::Lerp(Probe.Start, Probe.End, Probe.HitDistanceRatio),
+			              (Probe.bHit ? FLinearColor::Red : FLinearColor::Green).ToFColor(true),
+			              false, 0.0f, 0, UAlsDebugUtility::DrawLineThickness);
+		}
+#endif
+	}
+
+	// Probes are infinitely thin, so keep the camera away from the nearest hit by the trace radius.
+
+	const auto TraceDistance{(TraceEnd - TraceStart).Size()};
+
+	if (SafeDistanceRatio < 1.0f && TraceDistance > UE_KINDA_SMALL_NUMBER)
+	{
+		SafeDistanceRatio = FMath::Max(0.0f, SafeDistanceRatio - UE_REAL_TO_FLOAT(TraceRadius / TraceDistance));
+	}
+
+	return FMath::Lerp(TraceStart, TraceEnd, SafeDistanceRatio);
+}
+
+bool UAlsCameraComponent::TryGetAsyncCameraTraceResult(const FVector& TraceStart, const FVector& TraceEnd,
+                                                       const float MaxTraceDrift, FHitResult& Hit, FVector& TraceResult) const
+{
+	FTraceDatum TraceDatum;
+
+	if (!CameraTraceHandle.IsValid() || !GetWorld()->QueryTraceData(CameraTraceHandle, TraceDatum))
+	{
+		return false;
+	}
+
+	// The previous frame's hit distance only accounts for geometry near the previous trace, so if the trace has
+	// moved too far since then, the predicted camera location may clip through geometry that was never traced.
+
+	if (FVector::DistSquared(TraceDatum.Start, TraceStart) > FMath::Square(MaxTraceDrift) ||
+	    FVector::DistSquared(TraceDatum.End, TraceEnd) > FMath::Square(MaxTraceDrift))
+	{
+		return false;
+	}
+
+	const auto* BlockingHit{
+		TraceDatum.OutHits.FindByPredicate([](const FHitResult& TraceHit)
+		{
+			return TraceHit.bBlockingHit;
+		})
+	};
+
+	if (BlockingHit == nullptr)
+	{
+		Hit.Reset();
+		TraceResult = TraceEnd;
+		return true;
+	}
+
+	if (BlockingHit->bStartPenetrating)
+	{
+		// Resolving penetration requires the trace start to be adjusted, which can only be done synchronously.
+		return false;
+	}
+
+	Hit = *BlockingHit;
+	TraceResult = FMath::Lerp(TraceStart, TraceEnd, Hit.Time);
+
+	return true;
+}
+
+bool UAlsCameraComponent::TryAdjustLocationBlockedByGeometry(FVector& Location, const bool bDisplayDebugCameraTraces)
+{
 	const auto MeshScale{UE_REAL_TO_FLOAT(Character->GetMesh()->GetComponentScale().Z)};
 	const auto CollisionShape{FCollisionShape::MakeSphere((Settings->ThirdPerson.TraceRadius + 1.0f) * MeshScale)};
 
+	FVector CachedAdjustment;
+
+	if (TryGetCachedBlockedGeometryAdjustment(Location, CollisionShape.GetSphereRadius(), CachedAdjustment))
+	{
+		INC_DWORD_STAT(STAT_AlsCameraBlockedGeometryCacheHits)
+
+		Location += CachedAdjustment;
+		return BlockedGeometryCache.bLocationAdjusted;
+	}
+
+	INC_DWORD_STAT(STAT_AlsCameraBlockedGeometryCacheMisses)
+
+	const auto InitialLocation{Location};
+
+	BlockedGeometryCache.Primitives.Reset();
+
+	const auto bLocationAdjusted{AdjustLocationBlockedByGeometry(Location, CollisionShape, bDisplayDebugCameraTraces)};
+
+	// Don't cache the result if nothing was overlapped, because in that case there is nothing to track for movement.
+
+	BlockedGeometryCache.bValid = Settings->ThirdPerson.BlockedGeometryCacheRadius > 0.0f &&
+	                              Settings->ThirdPerson.BlockedGeometryCacheMaxAge > 0.0f &&
+	                              !BlockedGeometryCache.Primitives.IsEmpty();
+	BlockedGeometryCache.bLocationAdjusted = bLocationAdjusted;
+	BlockedGeometryCache.Location = InitialLocation;
+	BlockedGeometryCache.Adjustment = Location - InitialLocation;
+	BlockedGeometryCache.CollisionShapeRadius = CollisionShape.GetSphereRadius();
+	BlockedGeometryCache.Time = GetWorld()->GetTimeSeconds();
+
+	return bLocationAdjusted;
+}
+
+bool UAlsCameraComponent::TryGetCachedBlockedGeometryAdjustment(const FVector& Location, const float CollisionShapeRadius,
+                                                                FVector& Adjustment) const
+{
+	if (!BlockedGeometryCache.bValid || !FMath::IsNearlyEqual(BlockedGeometryCache.CollisionShapeRadius, CollisionShapeRadius) ||
+	    GetWorld()->GetTimeSeconds() - BlockedGeometryCache.Time > Settings->ThirdPerson.BlockedGeometryCacheMaxAge ||
+	    FVector::DistSquared(BlockedGeometryCache.Location, Location) > FMath::Square(Settings->ThirdPerson.BlockedGeometryCacheRadius))
+	{
+		return false;
+	}
+
+	for (const auto& [Primitive, Transform] : BlockedGeometryCache.Primitives)
+	{
+		if (!Primitive.IsValid() || !Primitive->GetComponentTransform().Equals(Transform))
+		{
+			return false;
+		}
+	}
+
+	Adjustment = BlockedGeometryCache.Adjustment;
+	return true;
+}
+
+bool UAlsCameraComponent::AdjustLocationBlockedByGeometry(FVector& Location, const FCollisionShape& CollisionShape,
+                                                          const bool bDisplayDebugCameraTraces)
+{
+	// Based on ComponentEncroachesBlockingGeometry_WithAdjustment().
+
+	const auto MeshScale{UE_REAL_TO_FLOAT(Character->GetMesh()->GetComponentScale().Z)};
+
 	static TArray<FOverlapResult> Overlaps;
 	check(Overlaps.IsEmpty())
 
@@ -495,6 +848,8 @@ bool UAlsCameraComponent::TryAdjustLocationBlockedByGeometry(FVector& Location,
 
 	static const FName OverlapMultiTraceTag{FString::Printf(TEXT("%hs (Overlap Multi)"), __FUNCTION__)};
 
+	INC_DWORD_STAT(STAT_AlsCameraTraceQueries)
+
 	if (!GetWorld()->OverlapMultiByChannel(Overlaps, Location, FQuat::Identity, Settings->ThirdPerson.TraceChannel,
 	                                       CollisionShape, {OverlapMultiTraceTag, false, GetOwner()}))
 	{
@@ -504,6 +859,18 @@ bool UAlsCameraComponent::TryAdjustLocationBlockedByGeometry(FVector& Location,
 	auto Adjustment{FVector::ZeroVector};
 	auto bAnyValidBlock{false};
 
+	// Record all blocking primitives before any of them can cause an early return, so that
+	// the cached result is invalidated when any of them moves, not just the ones processed.
+
+	for (const auto& Overlap : Overlaps)
+	{
+		if (Overlap.Component.IsValid() &&
+		    Overlap.Component->GetCollisionResponseToChannel(Settings->ThirdPerson.TraceChannel) == ECR_Block)
+		{
+			BlockedGeometryCache.Primitives.Emplace(Overlap.Component.Get(), Overlap.Component->GetComponentTransform());
+		}
+	}
+
 	FMTDResult MtdResult;
 
 	for (const auto& Overlap : Overlaps)
@@ -554,6 +921,8 @@ bool UAlsCameraComponent::TryAdjustLocationBlockedByGeometry(FVector& Location,
 
 	static const FName FreeSpaceTraceTag{FString::Printf(TEXT("%hs (Free Space Overlap)"), __FUNCTION__)};
 
+	INC_DWORD_STAT(STAT_AlsCameraTraceQueries)
+
 	return !GetWorld()->OverlapBlockingTestByChannel(Location, FQuat::Identity, Settings->ThirdPerson.TraceChannel,
 	                                                 FCollisionShape::MakeSphere(Settings->ThirdPerson.TraceRadius * MeshScale),
 	                                                 {FreeSpaceTraceTag, false, GetOwner()});
@@ -0,0 +1,80 @@
+#include "AlsCameraDormancySubsystem.h"
+
+#include "AlsCameraComponent.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsCameraDormancySubsystem)
+
+TStatId UAlsCameraDormancySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAlsCameraDormancySubsystem, STATGROUP_Tickables);
+}
+
+void UAlsCameraDormancySubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	RefreshCameras();
+}
+
+bool UAlsCameraDormancySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UAlsCameraDormancySubsystem::RegisterCamera(UAlsCameraComponent* Camera)
+{
+	Cameras.AddUnique(Camera);
+
+	RefreshCameras();
+}
+
+void UAlsCameraDormancySubsystem::UnregisterCamera(UAlsCameraComponent* Camera)
+{
+	Cameras.RemoveSwap(Camera);
+}
+
+void UAlsCameraDormancySubsystem::RefreshCameras()
+{
+	if (Cameras.IsEmpty())
+	{
+		return;
+	}
+
+	// Both the current and the pending view targets are considered viewed, since during
+	// a view target blend the player camera manager needs up-to-date views from both of them.
+
+	TArray<const AActor*, TInlineAllocator<4>> ViewTargets;
+
+	for (auto Iterator{GetWorld()->GetPlayerControllerIterator()}; Iterator; ++Iterator)
+	{
+		const auto* Player{Iterator->Get()};
+
+		if (!IsValid(Player) || !Player->IsLocalController())
+		{
+			continue;
+		}
+
+		ViewTargets.AddUnique(Player->GetViewTarget());
+
+		if (IsValid(Player->PlayerCameraManager) && IsValid(Player->PlayerCameraManager->PendingViewTarget.Target))
+		{
+			ViewTargets.AddUnique(Player->PlayerCameraManager->PendingViewTarget.Target);
+		}
+	}
+
+	for (auto Index{Cameras.Num() - 1}; Index >= 0; Index--)
+	{
+		auto* Camera{Cameras[Index].Get()};
+
+		if (!IsValid(Camera))
+		{
+			Cameras.RemoveAtSwap(Index, EAllowShrinking::No);
+			continue;
+		}
+
+		Camera->SetDormant(!ViewTargets.Contains(Camera->GetOwner()));
+	}
+}
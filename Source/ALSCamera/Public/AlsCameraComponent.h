@@ -1,5 +1,6 @@
 #pragma once
 
+#include "WorldCollision.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Utility/AlsMath.h"
 #include "AlsCameraComponent.generated.h"
@@ -7,6 +8,39 @@
 class UAlsCameraSettings;
 class ACharacter;
 
+struct FAlsCameraProbe
+{
+	FVector Start{ForceInit};
+
+	FVector End{ForceInit};
+
+	float HitDistanceRatio{1.0f};
+
+	uint8 bHit : 1 {false};
+
+	// Forces the probe to be traced again in the next frame.
+	uint8 bHitChanged : 1 {true};
+};
+
+struct FAlsCameraBlockedGeometryCache
+{
+	FVector Location{ForceInit};
+
+	FVector Adjustment{ForceInit};
+
+	float CollisionShapeRadius{0.0f};
+
+	// World time at which the adjustment was calculated.
+	double Time{0.0};
+
+	// All blocking primitives overlapped at the cached location and their transforms at the time of caching.
+	TArray<TPair<TWeakObjectPtr<const UPrimitiveComponent>, FTransform>, TInlineAllocator<4>> Primitives;
+
+	uint8 bValid : 1 {false};
+
+	uint8 bLocationAdjusted : 1 {false};
+};
+
 UCLASS(ClassGroup = "ALS", Meta = (BlueprintSpawnableComponent),
 	HideCategories = ("ComponentTick", "Clothing", "Physics", "MasterPoseComponent", "Collision", "AnimationRig",
 		"Lighting", "Deformer", "Rendering", "PathTracing", "HLOD", "Navigation", "VirtualTexture", "SkeletalMesh",
@@ -29,6 +63,12 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings", Meta = (ClampMin = 0, ClampMax = 1))
 	float PostProcessWeight{0.0f};
 
+	// If checked, only the animation curves of the camera animation blueprint are used, so all bones except
+	// the root bone are excluded from pose evaluation, and the camera mesh render state is not created in game.
+	// Uncheck this if the camera animation blueprint or any game code relies on the camera mesh bone transforms.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings", AdvancedDisplay)
+	uint8 bEvaluateCurvesOnly : 1 {true};
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
 	TObjectPtr<ACharacter> Character;
 
@@ -74,6 +114,22 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
 	uint8 bRightShoulder : 1 {true};
 
+	// The camera is dormant while its owner is not the view target of any local player controller. In this
+	// state, the component doesn't tick, so neither the animation instance nor the camera mesh are updated.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "State", Transient)
+	uint8 bDormant : 1 {false};
+
+	// Handle of the asynchronous camera trace requested in the previous frame. Used only when asynchronous camera traces are enabled.
+	FTraceHandle CameraTraceHandle;
+
+	FAlsCameraBlockedGeometryCache BlockedGeometryCache;
+
+	// Probes used to find the safe camera distance when the probe fan is enabled in the camera settings.
+	TArray<FAlsCameraProbe, TInlineAllocator<9>> Probes;
+
+	// Index of the probe that is forcibly refreshed in the current frame, advanced every frame in a round-robin fashion.
+	int32 ForcedRefreshProbeIndex{0};
+
 public:
 	UAlsCameraComponent();
 
@@ -87,8 +143,12 @@ public:
 
 	virtual void InitAnim(bool bForceReinitialize) override;
 
+	virtual bool ShouldCreateRenderState() const override;
+
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
+
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 	virtual void CompleteParallelAnimationEvaluation(bool bDoPostAnimationEvaluation) override;
@@ -114,6 +174,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ALS|Camera")
 	void SetRightShoulder(bool bNewRightShoulder);
 
+	bool IsDormant() const;
+
+	void SetDormant(bool bNewDormant);
+
 	UFUNCTION(BlueprintPure, Category = "ALS|Camera", Meta = (ReturnDisplayName = "Camera Location"))
 	FVector GetFirstPersonCameraLocation() const;
 
@@ -127,6 +191,8 @@ public:
 	void GetViewInfo(FMinimalViewInfo& ViewInfo) const;
 
 private:
+	void ExcludeNonRootBonesFromEvaluation();
+
 	void TickCamera(float DeltaTime, bool bAllowLag = true);
 
 	FRotator CalculateCameraRotation(const FRotator& CameraTargetRotation, float DeltaTime, bool bAllowLag) const;
@@ -140,9 +206,19 @@ private:
 	float CalculateFovOffset() const;
 
 	FVector CalculateCameraTrace(const FVector& CameraTargetLocation, const FVector& PivotOffset,
-	                             float DeltaTime, bool bAllowLag, float& NewTraceDistanceRatio) const;
+	                             float DeltaTime, bool bAllowLag, float& NewTraceDistanceRatio);
+
+	FVector CalculateProbeFanTraceResult(const FVector& TraceStart, const FVector& TraceEnd,
+	                                     float TraceRadius, bool bDisplayDebugCameraTraces);
+
+	bool TryGetAsyncCameraTraceResult(const FVector& TraceStart, const FVector& TraceEnd,
+	                                  float MaxTraceDrift, FHitResult& Hit, FVector& TraceResult) const;
+
+	bool TryAdjustLocationBlockedByGeometry(FVector& Location, bool bDisplayDebugCameraTraces);
 
-	bool TryAdjustLocationBlockedByGeometry(FVector& Location, bool bDisplayDebugCameraTraces) const;
+	bool TryGetCachedBlockedGeometryAdjustment(const FVector& Location, float CollisionShapeRadius, FVector& Adjustment) const;
+
+	bool AdjustLocationBlockedByGeometry(FVector& Location, const FCollisionShape& CollisionShape, bool bDisplayDebugCameraTraces);
 
 	// Debug
 
@@ -199,3 +275,8 @@ inline void UAlsCameraComponent::SetRightShoulder(const bool bNewRightShoulder)
 {
 	bRightShoulder = bNewRightShoulder;
 }
+
+inline bool UAlsCameraComponent::IsDormant() const
+{
+	return bDormant;
+}
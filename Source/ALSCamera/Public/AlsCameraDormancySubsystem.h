@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "AlsCameraDormancySubsystem.generated.h"
+
+class UAlsCameraComponent;
+
+// Puts camera components to sleep when their owners are not viewed by any local player controller,
+// and wakes them up as soon as they become the view target, for example, after a spectate switch.
+UCLASS()
+class ALSCAMERA_API UAlsCameraDormancySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+private:
+	TArray<TWeakObjectPtr<UAlsCameraComponent>> Cameras;
+
+public:
+	virtual TStatId GetStatId() const override;
+
+	virtual void Tick(float DeltaTime) override;
+
+protected:
+	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
+
+public:
+	void RegisterCamera(UAlsCameraComponent* Camera);
+
+	void UnregisterCamera(UAlsCameraComponent* Camera);
+
+	void RefreshCameras();
+};
@@ -26,6 +26,24 @@ struct ALSCAMERA_API FAlsTraceDistanceSmoothingSettings
 	float InterpolationSpeed{3.0f};
 };
 
+USTRUCT(BlueprintType)
+struct ALSCAMERA_API FAlsCameraProbeFanSettings
+{
+	GENERATED_BODY()
+
+	// The total number of line traces, including the central one that goes straight to the camera.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 1, ClampMax = 9))
+	int32 ProbeCount{5};
+
+	// Distance between the camera and the end locations of the probes surrounding the central one.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0, ForceUnits = "cm"))
+	float Radius{30.0f};
+
+	// A probe with an unchanged hit state is traced again only if its start or end location has moved farther than this distance.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0, ForceUnits = "cm"))
+	float RefreshDistance{5.0f};
+};
+
 USTRUCT(BlueprintType)
 struct ALSCAMERA_API FAlsThirdPersonCameraSettings
 {
@@ -55,12 +73,34 @@ struct ALSCAMERA_API FAlsThirdPersonCameraSettings
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS")
 	FVector3f TraceOverrideOffset{0.0f, 0.0f, 40.0f};
 
+	// If the trace start is blocked by geometry, the adjustment that pushes it out of that geometry is reused while the trace
+	// start stays within this distance of the location where the adjustment was calculated and none of the blocking
+	// primitives have moved. The reused adjustment may be off by up to this distance, so the default value matches the
+	// 1 cm margin by which the overlap sphere exceeds the trace radius. If zero is specified, the adjustment will be
+	// recalculated every frame.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0, ForceUnits = "cm"))
+	float BlockedGeometryCacheRadius{1.0f};
+
+	// The cache only tracks primitives that were blocking when the adjustment was calculated, so it cannot notice new
+	// geometry moving into the trace start. To bound how long such geometry can go unnoticed, the adjustment is
+	// recalculated at least once per this time. If zero is specified, the adjustment will be recalculated every frame.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (ClampMin = 0, ForceUnits = "s"))
+	float BlockedGeometryCacheMaxAge{0.1f};
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (InlineEditConditionToggle))
 	uint8 bEnableTraceDistanceSmoothing : 1 {true};
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS",
 		DisplayName = "Enable Trace Distance Smoothing", Meta = (EditCondition = "bEnableTraceDistanceSmoothing"))
 	FAlsTraceDistanceSmoothingSettings TraceDistanceSmoothing;
+
+	// If enabled, a fan of line traces whose results are held across frames is used instead of the sphere sweep.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS", Meta = (InlineEditConditionToggle))
+	uint8 bEnableProbeFan : 1 {false};
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ALS",
+		DisplayName = "Enable Probe Fan", Meta = (EditCondition = "bEnableProbeFan"))
+	FAlsCameraProbeFanSettings ProbeFan;
 };
 
 USTRUCT(BlueprintType)
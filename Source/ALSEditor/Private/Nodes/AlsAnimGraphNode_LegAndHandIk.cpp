@@ -0,0 +1,32 @@
+#include "Nodes/AlsAnimGraphNode_LegAndHandIk.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsAnimGraphNode_LegAndHandIk)
+
+#define LOCTEXT_NAMESPACE "AlsAnimGraphNode_LegAndHandIk"
+
+FText UAlsAnimGraphNode_LegAndHandIk::GetNodeTitle(const ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT("Title", "Leg and Hand IK");
+}
+
+FText UAlsAnimGraphNode_LegAndHandIk::GetTooltipText() const
+{
+	return LOCTEXT("Tooltip", "Native foot offset, foot lock and hand IK retargeting without the control rig overhead");
+}
+
+FString UAlsAnimGraphNode_LegAndHandIk::GetNodeCategory() const
+{
+	return FString{TEXTVIEW("ALS")};
+}
+
+FText UAlsAnimGraphNode_LegAndHandIk::GetControllerDescription() const
+{
+	return LOCTEXT("ControllerDescription", "Leg and Hand IK");
+}
+
+const FAnimNode_SkeletalControlBase* UAlsAnimGraphNode_LegAndHandIk::GetNode() const
+{
+	return &Node;
+}
+
+#undef LOCTEXT_NAMESPACE
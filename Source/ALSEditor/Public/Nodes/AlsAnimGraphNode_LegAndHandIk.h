@@ -0,0 +1,27 @@
+#pragma once
+
+#include "AnimGraphNode_SkeletalControlBase.h"
+#include "Nodes/AlsAnimNode_LegAndHandIk.h"
+#include "AlsAnimGraphNode_LegAndHandIk.generated.h"
+
+UCLASS()
+class ALSEDITOR_API UAlsAnimGraphNode_LegAndHandIk : public UAnimGraphNode_SkeletalControlBase
+{
+	GENERATED_BODY()
+
+protected:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings")
+	FAlsAnimNode_LegAndHandIk Node;
+
+public:
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+
+	virtual FText GetTooltipText() const override;
+
+	virtual FString GetNodeCategory() const override;
+
+protected:
+	virtual FText GetControllerDescription() const override;
+
+	virtual const FAnimNode_SkeletalControlBase* GetNode() const override;
+};
@@ -9,7 +9,6 @@
 #include "AlsMoverCharacter.h"
 #include "DefaultMovementSet/Settings/CommonLegacyMovementSettings.h"
 #include "AlsMoverMovementSettings.h"
-#include "KismetAnimationLibrary.h"
 #include "Utility/AlsGameplayTags.h"
 #include "MoverTypes.h"
 
@@ -444,12 +443,13 @@ void UAlsGroundMovementMode::SimulationTick_Implementation(const FSimulationTick
         OutputAlsState->YawSpeed = 0.0f;
     }
 
-    OutputAlsState->RelativeVelocity = CurrentRotation.UnrotateVector(CurrentVelocity);
-    OutputAlsState->VelocityYawAngle = UKismetAnimationLibrary::CalculateDirection(CurrentVelocity, CurrentRotation);
     OutputAlsState->ViewRotation = CharInput->ControlRotation;
     OutputAlsState->bHasMovementInput = !AlsInput->MoveInputVector.IsNearlyZero();
     OutputAlsState->PreviousVelocity = CurrentVelocity;
     OutputAlsState->PreviousRotation = CurrentRotation;
+
+    // Relative velocity and velocity yaw angle are calculated from the current velocity and rotation stored above
+    OutputAlsState->RefreshDerivedValues();
 }
 
 float UAlsGroundMovementMode::GetMaxSpeed() const
@@ -646,13 +646,15 @@ void AAlsMoverCharacter::DisplayDebug(UCanvas *Canvas, const FDebugDisplayInfo &
     static const FName NAME_AlsMoverInput("AlsMover.Input");
     static const FName NAME_AlsMoverStates("AlsMover.States");
     static const FName NAME_AlsMoverMovement("AlsMover.Movement");
+    static const FName NAME_AlsMoverReconcile("AlsMover.Reconcile");
 
     const bool bShowAlsMover = DebugDisplay.IsDisplayOn(NAME_AlsMover);
     const bool bShowInput = DebugDisplay.IsDisplayOn(NAME_AlsMoverInput);
     const bool bShowStates = DebugDisplay.IsDisplayOn(NAME_AlsMoverStates);
     const bool bShowMovement = DebugDisplay.IsDisplayOn(NAME_AlsMoverMovement);
+    const bool bShowReconcile = DebugDisplay.IsDisplayOn(NAME_AlsMoverReconcile);
 
-    if (!bShowAlsMover && !bShowInput && !bShowStates && !bShowMovement)
+    if (!bShowAlsMover && !bShowInput && !bShowStates && !bShowMovement && !bShowReconcile)
     {
         return;
     }
@@ -716,4 +718,26 @@ void AAlsMoverCharacter::DisplayDebug(UCanvas *Canvas, const FDebugDisplayInfo &
             YPos += YL;
         }
     }
+
+    // Show which sync state fields caused rollbacks (shared by all characters)
+    if (bShowAlsMover || bShowReconcile)
+    {
+        Canvas->SetDrawColor(HeaderColor);
+        Canvas->DrawText(Font, TEXT("[Sync State Reconciles - All Characters]"), 4.0f, YPos);
+        YPos += YL;
+
+        Canvas->SetDrawColor(ValueColor);
+        for (int32 FieldIndex = 0; FieldIndex < static_cast<int32>(EAlsMoverSyncStateField::Count); FieldIndex++)
+        {
+            const EAlsMoverSyncStateField Field = static_cast<EAlsMoverSyncStateField>(FieldIndex);
+            const uint32 ReconcilesCount = FAlsMoverSyncState::GetReconcilesCount(Field);
+
+            if (ReconcilesCount > 0)
+            {
+                Canvas->DrawText(Font, FString::Printf(TEXT("%s: %u"), FAlsMoverSyncState::GetFieldName(Field), ReconcilesCount),
+                                 20.0f, YPos);
+                YPos += YL;
+            }
+        }
+    }
 }
\ No newline at end of file
@@ -1,7 +1,99 @@
 #include "AlsMoverData.h"
 
+#include "AlsMoverReconcileSettings.h"
+#include "KismetAnimationLibrary.h"
+#include "MoverLog.h"
+#include "Engine/NetSerialization.h"
+#include "Utility/AlsUtility.h"
+
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AlsMoverData)
 
+static TAutoConsoleVariable<bool> CVarCompactSyncStateSerialization(
+    TEXT("ALS.Mover.CompactSyncStateSerialization"),
+    true,
+    TEXT("Send the ALS sync state in the compact format: tags as net indices, quantized vectors and rotators, default values skipped\n")
+    TEXT("and derived values recalculated on the receiver. The format is chosen by the sender, so this can be changed at runtime."));
+
+namespace AlsMoverDataConstants
+{
+    // Move and look input axes are quantized to signed bytes.
+    static constexpr float InputAxisQuantizationScale{127.0f};
+
+    static constexpr float QuantizedInputAxisTolerance{1.0f / InputAxisQuantizationScale};
+
+    // Matches the precision of SerializePackedVector<1, 24>(), used for the mouse world position.
+    static constexpr float QuantizedMouseWorldPositionTolerance{1.0f};
+}
+
+// Reconciliation is only checked on the game thread, so the counters don't need to be atomic.
+static uint32 ReconcilesCounts[static_cast<int32>(EAlsMoverSyncStateField::Count)];
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sync State Reconciles: Stance"), STAT_AlsMoverStanceReconciles, STATGROUP_Als)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sync State Reconciles: Gait"), STAT_AlsMoverGaitReconciles, STATGROUP_Als)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sync State Reconciles: Rotation Mode"), STAT_AlsMoverRotationModeReconciles, STATGROUP_Als)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sync State Reconciles: View Mode"), STAT_AlsMoverViewModeReconciles, STATGROUP_Als)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sync State Reconciles: Locomotion Mode"), STAT_AlsMoverLocomotionModeReconciles, STATGROUP_Als)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sync State Reconciles: Overlay Mode"), STAT_AlsMoverOverlayModeReconciles, STATGROUP_Als)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sync State Reconciles: Locomotion Action"), STAT_AlsMoverLocomotionActionReconciles, STATGROUP_Als)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sync State Reconciles: Acceleration"), STAT_AlsMoverAccelerationReconciles, STATGROUP_Als)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sync State Reconciles: View Rotation"), STAT_AlsMoverViewRotationReconciles, STATGROUP_Als)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sync State Reconciles: Yaw Speed"), STAT_AlsMoverYawSpeedReconciles, STATGROUP_Als)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sync State Reconciles: Previous Velocity"), STAT_AlsMoverPreviousVelocityReconciles, STATGROUP_Als)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sync State Reconciles: Previous Rotation"), STAT_AlsMoverPreviousRotationReconciles, STATGROUP_Als)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sync State Reconciles: Relative Velocity"), STAT_AlsMoverRelativeVelocityReconciles, STATGROUP_Als)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sync State Reconciles: Velocity Yaw Angle"), STAT_AlsMoverVelocityYawAngleReconciles, STATGROUP_Als)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sync State Reconciles: Has Movement Input"), STAT_AlsMoverHasMovementInputReconciles, STATGROUP_Als)
+
+static FAutoConsoleCommand ResetReconcilesCountsCommand(
+    TEXT("ALS.Mover.ResetReconcilesCounts"),
+    TEXT("Resets the ALS sync state reconciliation counters shown in the AlsMover.Reconcile debug display."),
+    FConsoleCommandDelegate::CreateStatic(&FAlsMoverSyncState::ResetReconcilesCounts));
+
+#if STATS
+static const FName ReconcileStatNames[] =
+{
+    GET_STATFNAME(STAT_AlsMoverStanceReconciles),
+    GET_STATFNAME(STAT_AlsMoverGaitReconciles),
+    GET_STATFNAME(STAT_AlsMoverRotationModeReconciles),
+    GET_STATFNAME(STAT_AlsMoverViewModeReconciles),
+    GET_STATFNAME(STAT_AlsMoverLocomotionModeReconciles),
+    GET_STATFNAME(STAT_AlsMoverOverlayModeReconciles),
+    GET_STATFNAME(STAT_AlsMoverLocomotionActionReconciles),
+    GET_STATFNAME(STAT_AlsMoverAccelerationReconciles),
+    GET_STATFNAME(STAT_AlsMoverViewRotationReconciles),
+    GET_STATFNAME(STAT_AlsMoverYawSpeedReconciles),
+    GET_STATFNAME(STAT_AlsMoverPreviousVelocityReconciles),
+    GET_STATFNAME(STAT_AlsMoverPreviousRotationReconciles),
+    GET_STATFNAME(STAT_AlsMoverRelativeVelocityReconciles),
+    GET_STATFNAME(STAT_AlsMoverVelocityYawAngleReconciles),
+    GET_STATFNAME(STAT_AlsMoverHasMovementInputReconciles)
+};
+
+static_assert(UE_ARRAY_COUNT(ReconcileStatNames) == static_cast<int32>(EAlsMoverSyncStateField::Count));
+#endif
+
+static void SerializeQuantizedInputVector(FArchive &Ar, FVector &InputVector)
+{
+    int8 QuantizedAxes[3] = {0, 0, 0};
+    if (Ar.IsSaving())
+    {
+        // Input axes are normally in the [-1, 1] range. Larger values, such as raw mouse deltas, are scaled down
+        // uniformly. This keeps their direction, which is all the movement modes use from the look input.
+        const FVector NormalizedInputVector = InputVector / FMath::Max(1.0, InputVector.GetAbsMax());
+
+        QuantizedAxes[0] = static_cast<int8>(FMath::RoundToInt32(NormalizedInputVector.X * AlsMoverDataConstants::InputAxisQuantizationScale));
+        QuantizedAxes[1] = static_cast<int8>(FMath::RoundToInt32(NormalizedInputVector.Y * AlsMoverDataConstants::InputAxisQuantizationScale));
+        QuantizedAxes[2] = static_cast<int8>(FMath::RoundToInt32(NormalizedInputVector.Z * AlsMoverDataConstants::InputAxisQuantizationScale));
+    }
+
+    Ar.Serialize(QuantizedAxes, sizeof(QuantizedAxes));
+
+    if (Ar.IsLoading())
+    {
+        InputVector = FVector(QuantizedAxes[0], QuantizedAxes[1], QuantizedAxes[2]) / AlsMoverDataConstants::InputAxisQuantizationScale;
+    }
+}
+
 //========================================================================
 // FAlsMoverInputs Implementation
 //========================================================================
@@ -10,9 +102,10 @@ bool FAlsMoverInputs::NetSerialize(FArchive &Ar, UPackageMap *Map, bool &bOutSuc
 {
     Super::NetSerialize(Ar, Map, bOutSuccess);
 
-    Ar << MoveInputVector;
-    Ar << LookInputVector;
-    Ar << MouseWorldPosition;
+    static constexpr int32 InputFlagsCount = 11;
+
+    // The mouse world position is only used by the top-down rotation, so it's not sent otherwise
+    const bool bSendMouseWorldPosition = bUseTopDownView && bHasValidMouseTarget;
 
     uint16 InputFlags = 0;
     if (Ar.IsSaving())
@@ -24,10 +117,14 @@ bool FAlsMoverInputs::NetSerialize(FArchive &Ar, UPackageMap *Map, bool &bOutSuc
                      (bIsAimingHeld ? (1 << 4) : 0) |
                      (bWantsToRoll ? (1 << 5) : 0) |
                      (bWantsToMantle ? (1 << 6) : 0) |
-                     (bUseTopDownView ? (1 << 7) : 0);
+                     (bUseTopDownView ? (1 << 7) : 0) |
+                     // Presence bits, zero vectors are not sent
+                     (!MoveInputVector.IsZero() ? (1 << 8) : 0) |
+                     (!LookInputVector.IsZero() ? (1 << 9) : 0) |
+                     (bSendMouseWorldPosition ? (1 << 10) : 0);
     }
 
-    Ar << InputFlags;
+    Ar.SerializeBits(&InputFlags, InputFlagsCount);
 
     if (Ar.IsLoading())
     {
@@ -41,7 +138,36 @@ bool FAlsMoverInputs::NetSerialize(FArchive &Ar, UPackageMap *Map, bool &bOutSuc
         bUseTopDownView = (InputFlags & (1 << 7)) != 0;
     }
 
-    bOutSuccess = true;
+    if ((InputFlags & (1 << 8)) != 0)
+    {
+        SerializeQuantizedInputVector(Ar, MoveInputVector);
+    }
+    else if (Ar.IsLoading())
+    {
+        MoveInputVector = FVector::ZeroVector;
+    }
+
+    if ((InputFlags & (1 << 9)) != 0)
+    {
+        SerializeQuantizedInputVector(Ar, LookInputVector);
+    }
+    else if (Ar.IsLoading())
+    {
+        LookInputVector = FVector::ZeroVector;
+    }
+
+    bool bMouseWorldPositionSuccess = true;
+
+    if ((InputFlags & (1 << 10)) != 0)
+    {
+        bMouseWorldPositionSuccess = SerializePackedVector<1, 24>(MouseWorldPosition, Ar);
+    }
+    else if (Ar.IsLoading())
+    {
+        MouseWorldPosition = FVector::ZeroVector;
+    }
+
+    bOutSuccess = bMouseWorldPositionSuccess && !Ar.IsError();
     return true;
 }
 
@@ -60,9 +186,14 @@ void FAlsMoverInputs::ToString(FAnsiStringBuilderBase &Out) const
 bool FAlsMoverInputs::ShouldReconcile(const FMoverDataStructBase &AuthorityState) const
 {
     const FAlsMoverInputs &AuthInputs = static_cast<const FAlsMoverInputs &>(AuthorityState);
-    return !MoveInputVector.Equals(AuthInputs.MoveInputVector, KINDA_SMALL_NUMBER) ||
-           !LookInputVector.Equals(AuthInputs.LookInputVector, KINDA_SMALL_NUMBER) ||
-           !MouseWorldPosition.Equals(AuthInputs.MouseWorldPosition, KINDA_SMALL_NUMBER) ||
+    // The mouse world position is only sent while it's used by the top-down rotation
+    const bool bCompareMouseWorldPosition = bUseTopDownView && bHasValidMouseTarget &&
+                                            AuthInputs.bUseTopDownView && AuthInputs.bHasValidMouseTarget;
+
+    return !MoveInputVector.Equals(AuthInputs.MoveInputVector, AlsMoverDataConstants::QuantizedInputAxisTolerance) ||
+           !LookInputVector.GetSafeNormal().Equals(AuthInputs.LookInputVector.GetSafeNormal(), AlsMoverDataConstants::QuantizedInputAxisTolerance) ||
+           (bCompareMouseWorldPosition && !MouseWorldPosition.Equals(AuthInputs.MouseWorldPosition,
+                                                                    AlsMoverDataConstants::QuantizedMouseWorldPositionTolerance)) ||
            bHasValidMouseTarget != AuthInputs.bHasValidMouseTarget ||
            bIsSprintHeld != AuthInputs.bIsSprintHeld ||
            bWantsToToggleWalk != AuthInputs.bWantsToToggleWalk ||
@@ -101,6 +232,19 @@ bool FAlsMoverSyncState::NetSerialize(FArchive &Ar, UPackageMap *Map, bool &bOut
 {
     Super::NetSerialize(Ar, Map, bOutSuccess);
 
+    uint8 bCompact = 0;
+    if (Ar.IsSaving())
+    {
+        bCompact = CVarCompactSyncStateSerialization.GetValueOnAnyThread() ? 1 : 0;
+    }
+    Ar.SerializeBits(&bCompact, 1);
+
+    if (bCompact != 0)
+    {
+        NetSerializeCompact(Ar, Map, bOutSuccess);
+        return true;
+    }
+
     Ar << Stance;
     Ar << Gait;
     Ar << RotationMode;
@@ -131,6 +275,102 @@ bool FAlsMoverSyncState::NetSerialize(FArchive &Ar, UPackageMap *Map, bool &bOut
     return true;
 }
 
+void FAlsMoverSyncState::NetSerializeCompact(FArchive &Ar, UPackageMap *Map, bool &bOutSuccess)
+{
+    static const FAlsMoverSyncState DefaultState;
+
+    static constexpr int32 FieldsCount = 11;
+
+    uint16 SentFields = 0;
+    if (Ar.IsSaving())
+    {
+        SentFields = (Stance != DefaultState.Stance ? (1 << 0) : 0) |
+                     (Gait != DefaultState.Gait ? (1 << 1) : 0) |
+                     (RotationMode != DefaultState.RotationMode ? (1 << 2) : 0) |
+                     (ViewMode != DefaultState.ViewMode ? (1 << 3) : 0) |
+                     (LocomotionMode != DefaultState.LocomotionMode ? (1 << 4) : 0) |
+                     (OverlayMode != DefaultState.OverlayMode ? (1 << 5) : 0) |
+                     (LocomotionAction != DefaultState.LocomotionAction ? (1 << 6) : 0) |
+                     (!Acceleration.IsZero() ? (1 << 7) : 0) |
+                     (!PreviousVelocity.IsZero() ? (1 << 8) : 0) |
+                     (YawSpeed != 0.0f ? (1 << 9) : 0) |
+                     (bHasMovementInput ? (1 << 10) : 0);
+    }
+    Ar.SerializeBits(&SentFields, FieldsCount);
+
+    bool bTagsSuccess = true;
+
+    // Tags are sent as net indices, which are compact when fast gameplay tag replication is enabled in the project settings
+    const auto SerializeTag = [&Ar, Map, SentFields, &bTagsSuccess](FGameplayTag &Tag, const FGameplayTag &DefaultTag, const int32 FieldIndex)
+    {
+        if ((SentFields & (1 << FieldIndex)) != 0)
+        {
+            bool bTagSuccess = true;
+            Tag.NetSerialize(Ar, Map, bTagSuccess);
+            bTagsSuccess &= bTagSuccess;
+        }
+        else if (Ar.IsLoading())
+        {
+            Tag = DefaultTag;
+        }
+    };
+
+    SerializeTag(Stance, DefaultState.Stance, 0);
+    SerializeTag(Gait, DefaultState.Gait, 1);
+    SerializeTag(RotationMode, DefaultState.RotationMode, 2);
+    SerializeTag(ViewMode, DefaultState.ViewMode, 3);
+    SerializeTag(LocomotionMode, DefaultState.LocomotionMode, 4);
+    SerializeTag(OverlayMode, DefaultState.OverlayMode, 5);
+    SerializeTag(LocomotionAction, DefaultState.LocomotionAction, 6);
+
+    bool bVectorsSuccess = true;
+
+    if ((SentFields & (1 << 7)) != 0)
+    {
+        bVectorsSuccess &= SerializePackedVector<10, 24>(Acceleration, Ar);
+    }
+    else if (Ar.IsLoading())
+    {
+        Acceleration = FVector::ZeroVector;
+    }
+
+    if ((SentFields & (1 << 8)) != 0)
+    {
+        bVectorsSuccess &= SerializePackedVector<10, 24>(PreviousVelocity, Ar);
+    }
+    else if (Ar.IsLoading())
+    {
+        PreviousVelocity = FVector::ZeroVector;
+    }
+
+    if ((SentFields & (1 << 9)) != 0)
+    {
+        Ar << YawSpeed;
+    }
+    else if (Ar.IsLoading())
+    {
+        YawSpeed = 0.0f;
+    }
+
+    ViewRotation.SerializeCompressedShort(Ar);
+    PreviousRotation.SerializeCompressedShort(Ar);
+
+    if (Ar.IsLoading())
+    {
+        bHasMovementInput = (SentFields & (1 << 10)) != 0;
+
+        RefreshDerivedValues();
+    }
+
+    bOutSuccess = bTagsSuccess && bVectorsSuccess && !Ar.IsError();
+}
+
+void FAlsMoverSyncState::RefreshDerivedValues()
+{
+    RelativeVelocity = PreviousRotation.UnrotateVector(PreviousVelocity);
+    VelocityYawAngle = UKismetAnimationLibrary::CalculateDirection(PreviousVelocity, PreviousRotation);
+}
+
 void FAlsMoverSyncState::ToString(FAnsiStringBuilderBase &Out) const
 {
     Super::ToString(Out);
@@ -179,22 +419,139 @@ void FAlsMoverSyncState::ToString(FAnsiStringBuilderBase &Out) const
 bool FAlsMoverSyncState::ShouldReconcile(const FMoverDataStructBase &AuthorityState) const
 {
     const FAlsMoverSyncState &AuthState = static_cast<const FAlsMoverSyncState &>(AuthorityState);
-    return Stance != AuthState.Stance ||
-           Gait != AuthState.Gait ||
-           RotationMode != AuthState.RotationMode ||
-           ViewMode != AuthState.ViewMode ||
-           LocomotionMode != AuthState.LocomotionMode ||
-           OverlayMode != AuthState.OverlayMode ||
-           LocomotionAction != AuthState.LocomotionAction ||
-           !Acceleration.Equals(AuthState.Acceleration, KINDA_SMALL_NUMBER) ||
-           !ViewRotation.Equals(AuthState.ViewRotation, KINDA_SMALL_NUMBER) ||
-           !FMath::IsNearlyEqual(YawSpeed, AuthState.YawSpeed, KINDA_SMALL_NUMBER) ||
-           !PreviousVelocity.Equals(AuthState.PreviousVelocity, KINDA_SMALL_NUMBER) ||
-           !PreviousRotation.Equals(AuthState.PreviousRotation, KINDA_SMALL_NUMBER) ||
-           !RelativeVelocity.Equals(AuthState.RelativeVelocity, KINDA_SMALL_NUMBER) ||
-           !FMath::IsNearlyEqual(VelocityYawAngle, AuthState.VelocityYawAngle, KINDA_SMALL_NUMBER) ||
-           bHasMovementInput != AuthState.bHasMovementInput ||
-           false; // Modifier handles are runtime-only and not compared for reconciliation
+
+    // Modifier handles are runtime-only and not compared for reconciliation
+    const EAlsMoverSyncStateField Field = FindReconcileField(AuthState);
+    if (Field == EAlsMoverSyncStateField::Count)
+    {
+        return false;
+    }
+
+    const int32 FieldIndex = static_cast<int32>(Field);
+
+    ReconcilesCounts[FieldIndex] += 1;
+
+#if STATS
+    INC_DWORD_STAT_FNAME_BY(ReconcileStatNames[FieldIndex], 1);
+#endif
+
+    UE_LOG(LogMover, Verbose, TEXT("ALS sync state reconciliation caused by %s"), GetFieldName(Field));
+    return true;
+}
+
+EAlsMoverSyncStateField FAlsMoverSyncState::FindReconcileField(const FAlsMoverSyncState &AuthState) const
+{
+    const UAlsMoverReconcileSettings *Settings = GetDefault<UAlsMoverReconcileSettings>();
+
+    const auto VectorDiffers = [](const FVector &Value, const FVector &AuthValue, const FAlsMoverReconcileTolerance &Tolerance)
+    {
+        return Tolerance.bCompare && !Value.Equals(AuthValue, Tolerance.Tolerance);
+    };
+
+    const auto RotatorDiffers = [](const FRotator &Value, const FRotator &AuthValue, const FAlsMoverReconcileTolerance &Tolerance)
+    {
+        return Tolerance.bCompare && !Value.Equals(AuthValue, Tolerance.Tolerance);
+    };
+
+    if (Stance != AuthState.Stance)
+    {
+        return EAlsMoverSyncStateField::Stance;
+    }
+    if (Gait != AuthState.Gait)
+    {
+        return EAlsMoverSyncStateField::Gait;
+    }
+    if (RotationMode != AuthState.RotationMode)
+    {
+        return EAlsMoverSyncStateField::RotationMode;
+    }
+    if (ViewMode != AuthState.ViewMode)
+    {
+        return EAlsMoverSyncStateField::ViewMode;
+    }
+    if (LocomotionMode != AuthState.LocomotionMode)
+    {
+        return EAlsMoverSyncStateField::LocomotionMode;
+    }
+    if (OverlayMode != AuthState.OverlayMode)
+    {
+        return EAlsMoverSyncStateField::OverlayMode;
+    }
+    if (LocomotionAction != AuthState.LocomotionAction)
+    {
+        return EAlsMoverSyncStateField::LocomotionAction;
+    }
+    if (VectorDiffers(Acceleration, AuthState.Acceleration, Settings->Acceleration))
+    {
+        return EAlsMoverSyncStateField::Acceleration;
+    }
+    if (RotatorDiffers(ViewRotation, AuthState.ViewRotation, Settings->ViewRotation))
+    {
+        return EAlsMoverSyncStateField::ViewRotation;
+    }
+    if (Settings->YawSpeed.bCompare && !FMath::IsNearlyEqual(YawSpeed, AuthState.YawSpeed, Settings->YawSpeed.Tolerance))
+    {
+        return EAlsMoverSyncStateField::YawSpeed;
+    }
+    if (VectorDiffers(PreviousVelocity, AuthState.PreviousVelocity, Settings->PreviousVelocity))
+    {
+        return EAlsMoverSyncStateField::PreviousVelocity;
+    }
+    if (RotatorDiffers(PreviousRotation, AuthState.PreviousRotation, Settings->PreviousRotation))
+    {
+        return EAlsMoverSyncStateField::PreviousRotation;
+    }
+    if (VectorDiffers(RelativeVelocity, AuthState.RelativeVelocity, Settings->RelativeVelocity))
+    {
+        return EAlsMoverSyncStateField::RelativeVelocity;
+    }
+    if (Settings->VelocityYawAngle.bCompare &&
+        FMath::Abs(FMath::FindDeltaAngleDegrees(VelocityYawAngle, AuthState.VelocityYawAngle)) > Settings->VelocityYawAngle.Tolerance)
+    {
+        return EAlsMoverSyncStateField::VelocityYawAngle;
+    }
+    if (Settings->bCompareHasMovementInput && bHasMovementInput != AuthState.bHasMovementInput)
+    {
+        return EAlsMoverSyncStateField::HasMovementInput;
+    }
+
+    return EAlsMoverSyncStateField::Count;
+}
+
+uint32 FAlsMoverSyncState::GetReconcilesCount(const EAlsMoverSyncStateField Field)
+{
+    return Field < EAlsMoverSyncStateField::Count ? ReconcilesCounts[static_cast<int32>(Field)] : 0;
+}
+
+const TCHAR *FAlsMoverSyncState::GetFieldName(const EAlsMoverSyncStateField Field)
+{
+    static const TCHAR *FieldNames[] =
+    {
+        TEXT("Stance"),
+        TEXT("Gait"),
+        TEXT("RotationMode"),
+        TEXT("ViewMode"),
+        TEXT("LocomotionMode"),
+        TEXT("OverlayMode"),
+        TEXT("LocomotionAction"),
+        TEXT("Acceleration"),
+        TEXT("ViewRotation"),
+        TEXT("YawSpeed"),
+        TEXT("PreviousVelocity"),
+        TEXT("PreviousRotation"),
+        TEXT("RelativeVelocity"),
+        TEXT("VelocityYawAngle"),
+        TEXT("HasMovementInput")
+    };
+
+    static_assert(UE_ARRAY_COUNT(FieldNames) == static_cast<int32>(EAlsMoverSyncStateField::Count));
+
+    return Field < EAlsMoverSyncStateField::Count ? FieldNames[static_cast<int32>(Field)] : TEXT("None");
+}
+
+void FAlsMoverSyncState::ResetReconcilesCounts()
+{
+    FMemory::Memzero(ReconcilesCounts);
 }
 
 void FAlsMoverSyncState::Interpolate(const FMoverDataStructBase &From, const FMoverDataStructBase &To, float Pct)
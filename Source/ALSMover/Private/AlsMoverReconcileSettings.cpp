@@ -0,0 +1,8 @@
+#include "AlsMoverReconcileSettings.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AlsMoverReconcileSettings)
+
+UAlsMoverReconcileSettings::UAlsMoverReconcileSettings()
+{
+    CategoryName = TEXT("Plugins");
+}
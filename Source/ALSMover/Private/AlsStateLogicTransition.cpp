@@ -11,6 +11,18 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AlsStateLogicTransition)
 
+// Evaluation runs every simulation tick and again for every resimulated frame, so its
+// logging is verbose only, and compiled out unless explicitly enabled for debugging.
+#ifndef ALS_STATE_LOGIC_VERBOSE_LOGGING
+#define ALS_STATE_LOGIC_VERBOSE_LOGGING 0
+#endif
+
+#if ALS_STATE_LOGIC_VERBOSE_LOGGING
+DEFINE_LOG_CATEGORY_STATIC(LogAlsStateLogic, Log, All);
+#else
+DEFINE_LOG_CATEGORY_STATIC(LogAlsStateLogic, Log, Warning);
+#endif
+
 UAlsStateLogicTransition::UAlsStateLogicTransition(const FObjectInitializer &ObjectInitializer)
     : Super(ObjectInitializer)
 {
@@ -18,14 +30,6 @@ UAlsStateLogicTransition::UAlsStateLogicTransition(const FObjectInitializer &Obj
 
 FTransitionEvalResult UAlsStateLogicTransition::Evaluate_Implementation(const FSimulationTickParams &Context) const
 {
-    // Log that this method is being called
-    static int32 CallCounter = 0;
-    if (CallCounter++ % 300 == 0) // Log every 5 seconds at 60fps
-    {
-        UE_LOG(LogTemp, Warning, TEXT("ALS StateLogicTransition::Evaluate_Implementation called - Counter: %d"),
-               CallCounter);
-    }
-
     // Get ALS-specific input and sync state
     const FAlsMoverInputs *AlsInputs = Context.StartState.InputCmd.InputCollection.FindDataByType<FAlsMoverInputs>();
     FAlsMoverSyncState *AlsSyncState = Context.StartState.SyncState.SyncStateCollection.FindMutableDataByType<
@@ -33,14 +37,9 @@ FTransitionEvalResult UAlsStateLogicTransition::Evaluate_Implementation(const FS
 
     if (!AlsInputs || !AlsSyncState)
     {
-        // Debug: Log if we can't find the required data types
-        static int32 MissingDataCounter = 0;
-        if (MissingDataCounter++ % 300 == 0) // Log every 5 seconds at 60fps
-        {
-            UE_LOG(LogTemp, Warning, TEXT("ALS StateLogic: Missing data types - AlsInputs=%s, AlsSyncState=%s"),
-                   AlsInputs ? TEXT("Found") : TEXT("MISSING"),
-                   AlsSyncState ? TEXT("Found") : TEXT("MISSING"));
-        }
+        UE_LOG(LogAlsStateLogic, Verbose, TEXT("ALS StateLogic: Missing data types - AlsInputs=%s, AlsSyncState=%s"),
+               AlsInputs ? TEXT("Found") : TEXT("MISSING"),
+               AlsSyncState ? TEXT("Found") : TEXT("MISSING"));
         return FTransitionEvalResult::NoTransition;
     }
 
@@ -50,45 +49,21 @@ FTransitionEvalResult UAlsStateLogicTransition::Evaluate_Implementation(const FS
         return FTransitionEvalResult::NoTransition;
     }
 
-    // Debug: Log transition evaluation periodically or when input events occur
-    static int32 EvaluationCounter = 0;
-    bool bHasInputEvents = AlsInputs->bWantsToToggleCrouch || AlsInputs->bWantsToToggleWalk ||
-                           AlsInputs->bIsAimingHeld || AlsInputs->bIsSprintHeld;
-
-    if (bHasInputEvents || (EvaluationCounter++ % 300 == 0))
-    {
-        UE_LOG(LogTemp, Warning,
-               TEXT(
-                   "ALS StateLogic: Evaluating - Crouch=%s, Walk=%s, Sprint=%s, Aim=%s, CurrentGait=%s, CurrentStance=%s, RotationMode=%s"
-               ),
-               AlsInputs->bWantsToToggleCrouch ? TEXT("YES") : TEXT("no"),
-               AlsInputs->bWantsToToggleWalk ? TEXT("YES") : TEXT("no"),
-               AlsInputs->bIsSprintHeld ? TEXT("YES") : TEXT("no"),
-               AlsInputs->bIsAimingHeld ? TEXT("YES") : TEXT("no"),
-               *AlsSyncState->Gait.ToString(),
-               *AlsSyncState->Stance.ToString(),
-               *AlsSyncState->RotationMode.ToString());
-    }
-
     // Evaluate state logic - order matters!
     EvaluateGaitLogic(AlsInputs, AlsSyncState, MoverComp);
     EvaluateStanceLogic(AlsInputs, AlsSyncState, MoverComp);
     EvaluateAimingLogic(AlsInputs, AlsSyncState, MoverComp);
 
-    if (bHasInputEvents || (EvaluationCounter++ % 300 == 0))
-    {
-        UE_LOG(LogTemp, Warning,
-               TEXT(
-                   "ALS StateLogic: Evaluated - Crouch=%s, Walk=%s, Sprint=%s, Aim=%s, CurrentGait=%s, CurrentStance=%s, RotationMode=%s"
-               ),
-               AlsInputs->bWantsToToggleCrouch ? TEXT("YES") : TEXT("no"),
-               AlsInputs->bWantsToToggleWalk ? TEXT("YES") : TEXT("no"),
-               AlsInputs->bIsSprintHeld ? TEXT("YES") : TEXT("no"),
-               AlsInputs->bIsAimingHeld ? TEXT("YES") : TEXT("no"),
-               *AlsSyncState->Gait.ToString(),
-               *AlsSyncState->Stance.ToString(),
-               *AlsSyncState->RotationMode.ToString());
-    }
+    UE_LOG(LogAlsStateLogic, VeryVerbose,
+           TEXT("ALS StateLogic: Evaluated - Crouch=%s, Walk=%s, Sprint=%s, Aim=%s, CurrentGait=%s, CurrentStance=%s, RotationMode=%s"),
+           AlsInputs->bWantsToToggleCrouch ? TEXT("YES") : TEXT("no"),
+           AlsInputs->bWantsToToggleWalk ? TEXT("YES") : TEXT("no"),
+           AlsInputs->bIsSprintHeld ? TEXT("YES") : TEXT("no"),
+           AlsInputs->bIsAimingHeld ? TEXT("YES") : TEXT("no"),
+           *AlsSyncState->Gait.ToString(),
+           *AlsSyncState->Stance.ToString(),
+           *AlsSyncState->RotationMode.ToString());
+
     // This transition doesn't change movement modes, only modifies state
     return FTransitionEvalResult::NoTransition;
 }
@@ -108,8 +83,7 @@ void UAlsStateLogicTransition::EvaluateGaitLogic(const FAlsMoverInputs *Inputs,
         }
         else
         {
-            auto WalkModifier = MakeShared<FALSWalkStateModifier>();
-            SyncState->WalkModifierHandle = MoverComp->QueueMovementModifier(WalkModifier);
+            SyncState->WalkModifierHandle = MoverComp->QueueMovementModifier(WalkModifierPool.Acquire());
         }
     }
 
@@ -120,8 +94,7 @@ void UAlsStateLogicTransition::EvaluateGaitLogic(const FAlsMoverInputs *Inputs,
         // If it's not already active, queue one.
         if (!SyncState->SprintModifierHandle.IsValid())
         {
-            auto SprintModifier = MakeShared<FALSSprintStateModifier>();
-            SyncState->SprintModifierHandle = MoverComp->QueueMovementModifier(SprintModifier);
+            SyncState->SprintModifierHandle = MoverComp->QueueMovementModifier(SprintModifierPool.Acquire());
         }
     }
     else
@@ -158,9 +131,8 @@ void UAlsStateLogicTransition::EvaluateGaitLogic(const FAlsMoverInputs *Inputs,
     // --- Part 3: Update the CurrentGait tag if it changed ---
     if (SyncState->Gait != TargetGait)
     {
-        FGameplayTag OldGait = SyncState->Gait;
+        UE_LOG(LogAlsStateLogic, Verbose, TEXT("ALS Gait changed from %s to %s"), *SyncState->Gait.ToString(), *TargetGait.ToString());
         SyncState->Gait = TargetGait;
-        UE_LOG(LogTemp, Warning, TEXT("ALS Gait changed from %s to %s"), *OldGait.ToString(), *TargetGait.ToString());
     }
 }
 
@@ -175,7 +147,13 @@ void UAlsStateLogicTransition::EvaluateStanceLogic(const FAlsMoverInputs *Inputs
     const UAlsMoverMovementSettings *MovementSettings = MoverComp->FindSharedSettings<UAlsMoverMovementSettings>();
     if (!MovementSettings)
     {
-        UE_LOG(LogTemp, Warning, TEXT("ALS Stance Logic: UAlsMoverMovementSettings not found!"));
+        // Warn only once, since this is a setup error that would otherwise be reported on every crouch toggle.
+        if (!bMovementSettingsMissingLogged)
+        {
+            bMovementSettingsMissingLogged = true;
+            UE_LOG(LogAlsStateLogic, Warning, TEXT("ALS Stance Logic: UAlsMoverMovementSettings not found on %s!"),
+                   *GetNameSafe(MoverComp->GetOwner()));
+        }
         return;
     }
 
@@ -189,34 +167,33 @@ void UAlsStateLogicTransition::EvaluateStanceLogic(const FAlsMoverInputs *Inputs
         SyncState->CrouchModifierHandle.Invalidate();
 
         // Queue effects for standing
-        auto StandEffect = MakeShared<FApplyCapsuleSizeEffect>();
+        auto StandEffect = CapsuleSizeEffectPool.Acquire();
         StandEffect->TargetHalfHeight = MovementSettings->StandingCapsuleHalfHeight;
         MoverComp->QueueInstantMovementEffect(StandEffect);
 
-        auto CrouchStateEffect = MakeShared<FAlsApplyCrouchStateEffect>();
+        auto CrouchStateEffect = CrouchStateEffectPool.Acquire();
         CrouchStateEffect->bIsCrouching = false;
         CrouchStateEffect->HeightDifference = HeightDifference;
         MoverComp->QueueInstantMovementEffect(CrouchStateEffect);
 
-        UE_LOG(LogTemp, Log, TEXT("ALS State Logic: Uncrouch requested."));
+        UE_LOG(LogAlsStateLogic, Verbose, TEXT("ALS State Logic: Uncrouch requested."));
     }
     else
     {
         // Requesting to CROUCH
-        auto CrouchModifier = MakeShared<FALSStanceModifier>();
-        SyncState->CrouchModifierHandle = MoverComp->QueueMovementModifier(CrouchModifier);
+        SyncState->CrouchModifierHandle = MoverComp->QueueMovementModifier(CrouchModifierPool.Acquire());
 
         // Queue effects for crouching
-        auto CrouchEffect = MakeShared<FApplyCapsuleSizeEffect>();
+        auto CrouchEffect = CapsuleSizeEffectPool.Acquire();
         CrouchEffect->TargetHalfHeight = MovementSettings->CrouchingCapsuleHalfHeight;
         MoverComp->QueueInstantMovementEffect(CrouchEffect);
 
-        auto CrouchStateEffect = MakeShared<FAlsApplyCrouchStateEffect>();
+        auto CrouchStateEffect = CrouchStateEffectPool.Acquire();
         CrouchStateEffect->bIsCrouching = true;
         CrouchStateEffect->HeightDifference = HeightDifference;
         MoverComp->QueueInstantMovementEffect(CrouchStateEffect);
 
-        UE_LOG(LogTemp, Log, TEXT("ALS State Logic: Crouch requested. Handle: %s"),
+        UE_LOG(LogAlsStateLogic, Verbose, TEXT("ALS State Logic: Crouch requested. Handle: %s"),
                *SyncState->CrouchModifierHandle.ToString());
     }
 }
@@ -225,21 +202,6 @@ void UAlsStateLogicTransition::EvaluateStanceLogic(const FAlsMoverInputs *Inputs
 void UAlsStateLogicTransition::EvaluateAimingLogic(const FAlsMoverInputs *Inputs, FAlsMoverSyncState *SyncState,
                                                    UMoverComponent *MoverComp) const
 {
-    const UAlsMoverMovementSettings *AlsSettings = MoverComp->FindSharedSettings<UAlsMoverMovementSettings>();
-    if (!AlsSettings)
-    {
-        // Log a warning if settings are missing, but only once to avoid spam
-        static bool bLoggedMissingSettings = false;
-        if (!bLoggedMissingSettings)
-        {
-            UE_LOG(LogTemp, Warning,
-                   TEXT(
-                       "AlsStateLogicTransition: UAlsMoverMovementSettings not found on Mover Component. Rotation rates will use defaults."
-                   ));
-            bLoggedMissingSettings = true;
-        }
-    }
-
     const bool bShouldBeAiming = Inputs->bIsAimingHeld;
     const bool bIsCurrentlyAiming = SyncState->OverlayMode == AlsOverlayModeTags::Aiming;
 
@@ -254,11 +216,19 @@ void UAlsStateLogicTransition::EvaluateAimingLogic(const FAlsMoverInputs *Inputs
 
             if (!SyncState->AimModifierHandle.IsValid())
             {
-                auto AimModifier = MakeShared<FALSRotationRateModifier>();
+                // Settings are only needed when the aim modifier is queued, so they are not looked up every tick
+                const UAlsMoverMovementSettings *AlsSettings = MoverComp->FindSharedSettings<UAlsMoverMovementSettings>();
+                if (!AlsSettings)
+                {
+                    UE_LOG(LogAlsStateLogic, Verbose,
+                           TEXT("AlsStateLogicTransition: UAlsMoverMovementSettings not found on Mover Component. Rotation rates will use defaults."));
+                }
+
+                auto AimModifier = AimModifierPool.Acquire();
                 AimModifier->NewRotationRate = AlsSettings ? AlsSettings->AimRotationRate : 360.0f;
                 // Use settings or fallback
                 SyncState->AimModifierHandle = MoverComp->QueueMovementModifier(AimModifier);
-                UE_LOG(LogTemp, Log, TEXT("ALS State Logic: Started Aiming. Queued Aim Modifier. Handle: %s"),
+                UE_LOG(LogAlsStateLogic, Verbose, TEXT("ALS State Logic: Started Aiming. Queued Aim Modifier. Handle: %s"),
                        *SyncState->AimModifierHandle.ToString());
             }
         }
@@ -273,7 +243,7 @@ void UAlsStateLogicTransition::EvaluateAimingLogic(const FAlsMoverInputs *Inputs
             {
                 MoverComp->CancelModifierFromHandle(SyncState->AimModifierHandle);
                 SyncState->AimModifierHandle.Invalidate(); // Crucial to reset the handle
-                UE_LOG(LogTemp, Log, TEXT("ALS State Logic: Stopped Aiming. Cancelled Aim Modifier."));
+                UE_LOG(LogAlsStateLogic, Verbose, TEXT("ALS State Logic: Stopped Aiming. Cancelled Aim Modifier."));
             }
         }
     }
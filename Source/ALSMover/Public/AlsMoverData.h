@@ -70,6 +70,29 @@ struct ALSMOVER_API FAlsMoverInputs : public FMoverDataStructBase
     virtual void Interpolate(const FMoverDataStructBase &From, const FMoverDataStructBase &To, float Pct) override;
 };
 
+/**
+ * Fields of FAlsMoverSyncState that can cause a reconciliation, used for rollback diagnostics.
+ */
+enum class EAlsMoverSyncStateField : uint8
+{
+    Stance,
+    Gait,
+    RotationMode,
+    ViewMode,
+    LocomotionMode,
+    OverlayMode,
+    LocomotionAction,
+    Acceleration,
+    ViewRotation,
+    YawSpeed,
+    PreviousVelocity,
+    PreviousRotation,
+    RelativeVelocity,
+    VelocityYawAngle,
+    HasMovementInput,
+    Count
+};
+
 /**
  * ALS-specific sync state for networking.
  * This is the canonical, networked state of the character.
@@ -150,6 +173,23 @@ struct ALSMOVER_API FAlsMoverSyncState : public FMoverDataStructBase
     virtual void ToString(FAnsiStringBuilderBase &Out) const override;
     virtual bool ShouldReconcile(const FMoverDataStructBase &AuthorityState) const override;
     virtual void Interpolate(const FMoverDataStructBase &From, const FMoverDataStructBase &To, float Pct) override;
+
+    // Recalculates RelativeVelocity and VelocityYawAngle from PreviousVelocity and PreviousRotation,
+    // which at the end of a movement tick are equal to the current velocity and rotation.
+    void RefreshDerivedValues();
+
+    // Rollback diagnostics: number of reconciliations caused by the given field since the last reset.
+    static uint32 GetReconcilesCount(EAlsMoverSyncStateField Field);
+    static const TCHAR *GetFieldName(EAlsMoverSyncStateField Field);
+    static void ResetReconcilesCounts();
+
+private:
+    // Returns the first field that differs from the authority state beyond its tolerance, or EAlsMoverSyncStateField::Count.
+    EAlsMoverSyncStateField FindReconcileField(const FAlsMoverSyncState &AuthState) const;
+
+    // Sends only authoritative fields, skips tags equal to their defaults and zero values,
+    // quantizes vectors and rotators, and recalculates derived fields after loading.
+    void NetSerializeCompact(FArchive &Ar, class UPackageMap *Map, bool &bOutSuccess);
 };
 
 /**
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "AlsMoverReconcileSettings.generated.h"
+
+/**
+ * How a single FAlsMoverSyncState field is compared against the authority state during reconciliation.
+ */
+USTRUCT(BlueprintType)
+struct ALSMOVER_API FAlsMoverReconcileTolerance
+{
+    GENERATED_BODY()
+
+    // If unchecked, differences in this field never trigger a rollback and resimulation.
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS Mover")
+    uint8 bCompare : 1 {true};
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "ALS Mover", meta = (ClampMin = "0", UIMin = "0", EditCondition = "bCompare"))
+    float Tolerance = 0.0f;
+
+    FAlsMoverReconcileTolerance() = default;
+
+    FAlsMoverReconcileTolerance(bool bInCompare, float InTolerance)
+        : bCompare(bInCompare), Tolerance(InTolerance)
+    {
+    }
+};
+
+/**
+ * Per-field reconciliation tolerances for FAlsMoverSyncState. Gameplay tags are always compared exactly.
+ * Animation data derived from the default sync state (velocity and orientation) is excluded by default,
+ * since the default sync state is already reconciled by Mover, and any difference in the derived data
+ * alone would only cause a needless rollback and resimulation.
+ */
+UCLASS(Config = Game, DefaultConfig, meta = (DisplayName = "ALS Mover Reconciliation"))
+class ALSMOVER_API UAlsMoverReconcileSettings : public UDeveloperSettings
+{
+    GENERATED_BODY()
+
+public:
+    UAlsMoverReconcileSettings();
+
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Reconciliation", meta = (ForceUnits = "cm/s^2"))
+    FAlsMoverReconcileTolerance Acceleration{false, 0.1f};
+
+    // The default tolerance matches the precision of the compact sync state serialization.
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Reconciliation", meta = (ForceUnits = "deg"))
+    FAlsMoverReconcileTolerance ViewRotation{true, 0.01f};
+
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Reconciliation", meta = (ForceUnits = "deg/s"))
+    FAlsMoverReconcileTolerance YawSpeed{false, 0.1f};
+
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Reconciliation", meta = (ForceUnits = "cm/s"))
+    FAlsMoverReconcileTolerance PreviousVelocity{false, 0.1f};
+
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Reconciliation", meta = (ForceUnits = "deg"))
+    FAlsMoverReconcileTolerance PreviousRotation{false, 0.01f};
+
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Reconciliation", meta = (ForceUnits = "cm/s"))
+    FAlsMoverReconcileTolerance RelativeVelocity{false, 0.2f};
+
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Reconciliation", meta = (ForceUnits = "deg"))
+    FAlsMoverReconcileTolerance VelocityYawAngle{false, 1.0f};
+
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Reconciliation")
+    uint8 bCompareHasMovementInput : 1 {true};
+};
@@ -3,12 +3,40 @@
 #include "CoreMinimal.h"
 #include "MoverTypes.h"
 #include "MovementMode.h"
+#include "AlsMovementEffects.h"
+#include "AlsMovementModifiers.h"
 #include "AlsStateLogicTransition.generated.h"
 
+/**
+ * Keeps a single instance of a movement modifier or effect and reuses it once Mover no longer references it,
+ * so that queueing modifiers and effects doesn't allocate memory in the steady state, including during resimulation.
+ */
+template <typename T>
+struct TAlsMoverInstancePool
+{
+    TSharedPtr<T> Instance;
+
+    TSharedPtr<T> Acquire()
+    {
+        if (Instance.IsValid() && Instance.GetSharedReferenceCount() == 1)
+        {
+            *Instance = T();
+        }
+        else
+        {
+            Instance = MakeShared<T>();
+        }
+
+        return Instance;
+    }
+};
+
 /**
  * Global transition that handles ALS state changes based on input.
  * This transition manages gait, stance, and other state changes without
  * actually transitioning to a new movement mode.
+ * The evaluation is deterministic: all state lives in FAlsMoverSyncState, so replaying a frame during
+ * resimulation produces the same result. Modifiers and effects come from per-transition pools.
  */
 UCLASS(BlueprintType, Blueprintable)
 class ALSMOVER_API UAlsStateLogicTransition : public UBaseMovementModeTransition
@@ -31,4 +59,16 @@ protected:
     
     // Helper to check if a modifier is active
     bool IsModifierActive(const UMoverComponent* MoverComp, const FMovementModifierHandle& Handle) const;
+
+private:
+    // Evaluation is const, but acquiring a pooled instance updates the pool
+    mutable TAlsMoverInstancePool<FALSWalkStateModifier> WalkModifierPool;
+    mutable TAlsMoverInstancePool<FALSSprintStateModifier> SprintModifierPool;
+    mutable TAlsMoverInstancePool<FALSStanceModifier> CrouchModifierPool;
+    mutable TAlsMoverInstancePool<FALSRotationRateModifier> AimModifierPool;
+    mutable TAlsMoverInstancePool<FApplyCapsuleSizeEffect> CapsuleSizeEffectPool;
+    mutable TAlsMoverInstancePool<FAlsApplyCrouchStateEffect> CrouchStateEffectPool;
+
+    // Each mover component has its own transition instance, so the missing settings warning is logged once per component
+    mutable bool bMovementSettingsMissingLogged = false;
 };
\ No newline at end of file